@@ -147,7 +147,7 @@ void achievements_check(AchievementsData* data, Game* game) {
                 achievements_unlock(data, ACHIEVEMENT_WIN_25_GAMES);
             }
             
-            if (game->mode == MODE_AI_HARD) {
+            if (game->mode == MODE_AI_HARD || game->mode == MODE_AI_MCTS) {
                 achievements_unlock(data, ACHIEVEMENT_UNBEATABLE_BEATEN);
             }
             
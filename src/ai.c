@@ -1,190 +1,1239 @@
 #include "ai.h"
-#include <stdlib.h>
-#include <limits.h>
+#include "book.h"
+#include "dfpn.h"
+#include "enddb.h"
+#include "mcts.h"
+#include "monotime.h"
+#include "perfect.h"
+#include "position.h"
+#include "rng.h"
+#include "symmetry.h"
+#include "thread.h"
+#include "ttable.h"
+#include <string.h>
 
-static Move findWinningMove(Game* game, Player player);
-static int minimax(Game* game, int depth, Player ai_player, Player human_player, int alpha, int beta);
+#define AI_SCORE_WIN 10000
+#define AI_SCORE_INF 30000
+#define AI_SCORE_MATE_BOUND AI_SCORE_DECIDED
+#define AI_EVAL_LIMIT (AI_SCORE_MATE_BOUND - 1)
+#define AI_MAX_DEPTH 6
 
-void ai_get_move(Game* game, Move* move) {
-    if (!game || !move) return;
-    
-    if (game->mode < MODE_AI_EASY || game->mode > MODE_AI_HARD) return;
-    
+#define AI_MAX_PLY 32
+#define AI_MAX_CELLS (BITBOARD_MAX_SIZE * BITBOARD_MAX_SIZE)
+#define AI_NO_KILLER 0xFF
+#define AI_HISTORY_LIMIT (1u << 24)
+#define AI_CLOCK_CHECK_MASK 1023u
+#define AI_RUN_WEIGHT_CAP 5
+
+/* A ponder guesses the opponent's reply with a short search, then thinks
+ * about its answer until the move arrives or the limit runs out. */
+#define AI_PONDER_PREDICT_MS 200
+#define AI_PONDER_LIMIT_MS 30000
+
+/* Empty cells at or below which hard mode solves exactly instead of
+ * searching with the evaluator, by board size. Tuned with
+ * tictactoe-endgame-bench so the worst late-game solve stays well under
+ * the default move time on one thread. */
+static const int kExactEmpties[BITBOARD_MAX_SIZE + 1] = {0, 0, 0, 9, 16, 18};
+
+/* The proof-number solver gets a quarter of the move's time, or this many
+ * nodes when there is no deadline, before the alpha-beta search runs. */
+#define AI_SOLVER_TIME_DIVISOR 4
+#define AI_SOLVER_NODES 100000
+
+/* Value of a line only one side occupies, by its stone count. */
+static const int kLineWeight[BITBOARD_MAX_SIZE + 1] = {0, 1, 4, 16, 64, 256};
+
+/* Ordering keys above any history score. */
+#define AI_ORDER_TT (1u << 30)
+#define AI_ORDER_BLOCK (1u << 29)
+#define AI_ORDER_KILLER (1u << 28)
+
+typedef struct {
+    BitboardWinKernel has_win;
+    const WinMask* lines;
+    int line_count;
+    TransTable* table;
+    uint64_t deadline_ms;
+    const volatile int* abort;
+    uint64_t nodes;
+    uint64_t tt_probes;
+    uint64_t tt_hits;
+    uint64_t cutoffs[AI_STATS_CUTOFF_SLOTS];
+    int max_ply;
+    bool stopped;
+    uint8_t killers[AI_MAX_PLY][2];
+    uint32_t history[2][AI_MAX_CELLS];
+    /* Kept up to date by makeMove/unmakeMove: stones per line, and per
+     * side the weight of the lines it alone occupies and how many of
+     * those are one stone short of winning. */
+    uint8_t win_length;
+    uint8_t cell_lines[AI_MAX_CELLS][BITBOARD_MAX_CELL_MASKS];
+    uint8_t cell_line_count[AI_MAX_CELLS];
+    uint8_t line_stones[2][BITBOARD_MAX_WIN_MASKS];
+    int line_score[2];
+    int threats[2];
+} Search;
+
+/* One Lazy SMP thread: its own board copy and root order, sharing only
+ * the transposition table with the others. */
+typedef struct {
+    Search search;
+    Position pos;
+    const MoveList* moves;
+    Bitboard skip;
+    int first_depth;
+    int max_depth;
+    int rotate;
+    int best;
+    int score;
+    int completed;
+    AiStats* stats;     /* iteration times, main worker only */
+} Worker;
+
+static TransTable g_table;
+static size_t g_table_megabytes = AI_DEFAULT_HASH_MB;
+static bool g_table_ready = false;
+static int g_threads = 1;
+static int g_playouts = MCTS_DEFAULT_PLAYOUTS;
+static AiStats g_stats;
+
+/* Raised by ai_cancel(); every search thread polls it with its clock. */
+static volatile int g_cancel = 0;
+static size_t g_solver_megabytes = DFPN_DEFAULT_TABLE_MB;
+static int g_exact_empties = AI_EXACT_AUTO;
+
+typedef enum {
+    REQUEST_MOVE,
+    REQUEST_PONDER,
+    REQUEST_ANALYSIS
+} RequestKind;
+
+typedef struct {
+    Game game;
+    Move move;
+    AiMoveAnalysis analysis[MAX_MOVES];
+    int analysis_count;
+    uint64_t deadline_ms;
+    Thread thread;
+    volatile int done;
+    bool active;
+    bool ponder;
+    bool analyze;
+} AsyncRequest;
+
+/* What the last ponder found for the position after its predicted reply. */
+typedef struct {
+    uint64_t hash;
+    Move move;
+    uint64_t elapsed_ms;
+    bool finished;
+    bool valid;
+} PonderResult;
+
+static AsyncRequest g_request;
+static PonderResult g_ponder;
+
+static int negamax(Search* search, Position* pos, int depth, int ply, int alpha, int beta);
+static int solveExact(Search* search, Position* pos, int ply, int alpha, int beta);
+static Bitboard symmetricDuplicates(const Game* game);
+static bool forcedLineLikely(const Position* pos);
+static int analyzeMoves(const Game* game, uint64_t deadline_ms, AiMoveAnalysis* results, int max);
+
+void ai_set_hash_size(size_t megabytes) {
+    if (g_table_ready && megabytes == g_table_megabytes) return;
+    ai_cancel();
+    ttable_free(&g_table);
+    g_table_megabytes = megabytes;
+    g_table_ready = false;
+}
+
+bool ai_load_endgame_db(const char* path) {
+    return enddb_open(path);
+}
+
+bool ai_load_opening_book(const char* path) {
+    return book_load(path);
+}
+
+void ai_set_threads(int threads) {
+    if (threads < 1) threads = 1;
+    if (threads > AI_MAX_THREADS) threads = AI_MAX_THREADS;
+    g_threads = threads;
+}
+
+void ai_set_playouts(int playouts) {
+    g_playouts = (playouts > 0) ? playouts : 0;
+}
+
+void ai_set_solver_size(size_t megabytes) {
+    if (megabytes == g_solver_megabytes) return;
+    ai_cancel();
+    dfpn_set_table_size(megabytes);
+    g_solver_megabytes = megabytes;
+}
+
+void ai_set_exact_endgame(int empties) {
+    g_exact_empties = (empties < 0) ? AI_EXACT_AUTO : empties;
+}
+
+int ai_exact_endgame_empties(uint8_t size) {
+    if (size > BITBOARD_MAX_SIZE) return 0;
+    return (g_exact_empties == AI_EXACT_AUTO) ? kExactEmpties[size] : g_exact_empties;
+}
+
+void ai_clear_hash(void) {
+    if (g_table_ready) ttable_clear(&g_table);
+    dfpn_clear();
+}
+
+uint64_t ai_last_node_count(void) {
+    return g_stats.nodes;
+}
+
+void ai_last_stats(AiStats* stats) {
+    if (stats) *stats = g_stats;
+}
+
+const char* ai_source_name(AiSource source) {
+    switch (source) {
+        case AI_SOURCE_RANDOM: return "random";
+        case AI_SOURCE_RULES: return "rules";
+        case AI_SOURCE_PERFECT: return "perfect table";
+        case AI_SOURCE_ENDGAME_DB: return "endgame db";
+        case AI_SOURCE_BOOK: return "opening book";
+        case AI_SOURCE_SEARCH: return "search";
+        case AI_SOURCE_MCTS: return "mcts";
+        case AI_SOURCE_SOLVER: return "solver";
+        case AI_SOURCE_EXACT: return "exact endgame";
+        default: return "none";
+    }
+}
+
+static TransTable* sharedTable(void) {
+    if (!g_table_ready) {
+        g_table_ready = ttable_init(&g_table, g_table_megabytes);
+    }
+    return g_table_ready ? &g_table : NULL;
+}
+
+static void setMove(const Game* game, Move* move, uint16_t cell) {
+    move->row = (uint8_t)(cell / game->size);
+    move->col = (uint8_t)(cell % game->size);
+}
+
+static void initEval(Search* search, const Game* game, const Position* pos) {
     const uint8_t n = game->size;
-    const Player ai_player = game->current_player;
-    const Player human_player = (ai_player == PLAYER_X) ? PLAYER_O : PLAYER_X;
-    
-    move->row = n;
-    move->col = n;
-    
-    if (game->mode == MODE_AI_EASY) {
-        uint8_t available[MAX_MOVES];
-        uint8_t count = 0;
-        
-        for (uint8_t i = 0; i < n; i++) {
-            for (uint8_t j = 0; j < n; j++) {
-                if (game->board[i][j] == PLAYER_NONE) {
-                    available[count++] = (uint8_t)(i * n + j);
-                }
+    const int k = game->win_length;
+
+    search->win_length = game->win_length;
+    for (int cell = 0; cell < n * n; cell++) {
+        int count = 0;
+        const uint8_t* lines = bitboard_cell_masks(n, game->win_length, (uint8_t)cell, &count);
+        memcpy(search->cell_lines[cell], lines, (size_t)count);
+        search->cell_line_count[cell] = (uint8_t)count;
+    }
+
+    memset(search->line_score, 0, sizeof(search->line_score));
+    memset(search->threats, 0, sizeof(search->threats));
+    for (int i = 0; i < search->line_count; i++) {
+        const Bitboard mask = search->lines[i].mask;
+        const int x = bitboard_popcount(position_stones(pos, PLAYER_X) & mask);
+        const int o = bitboard_popcount(position_stones(pos, PLAYER_O) & mask);
+        search->line_stones[0][i] = (uint8_t)x;
+        search->line_stones[1][i] = (uint8_t)o;
+        if (x > 0 && o == 0) {
+            search->line_score[0] += kLineWeight[x];
+            if (x == k - 1) search->threats[0]++;
+        } else if (o > 0 && x == 0) {
+            search->line_score[1] += kLineWeight[o];
+            if (o == k - 1) search->threats[1]++;
+        }
+    }
+}
+
+static void makeMove(Search* search, Position* pos, int cell) {
+    const int me = position_side(pos) - 1;
+    const int them = me ^ 1;
+    const int k = search->win_length;
+
+    for (int i = 0; i < search->cell_line_count[cell]; i++) {
+        const int line = search->cell_lines[cell][i];
+        const int mine = search->line_stones[me][line]++;
+        const int theirs = search->line_stones[them][line];
+        if (theirs == 0) {
+            search->line_score[me] += kLineWeight[mine + 1] - kLineWeight[mine];
+            if (mine + 1 == k - 1) search->threats[me]++;
+            else if (mine + 1 == k) search->threats[me]--;
+        } else if (mine == 0) {
+            search->line_score[them] -= kLineWeight[theirs];
+            if (theirs == k - 1) search->threats[them]--;
+        }
+    }
+    position_make(pos, cell);
+}
+
+static void unmakeMove(Search* search, Position* pos, int cell) {
+    position_unmake(pos, cell);
+    const int me = position_side(pos) - 1;
+    const int them = me ^ 1;
+    const int k = search->win_length;
+
+    for (int i = 0; i < search->cell_line_count[cell]; i++) {
+        const int line = search->cell_lines[cell][i];
+        const int mine = --search->line_stones[me][line];
+        const int theirs = search->line_stones[them][line];
+        if (theirs == 0) {
+            search->line_score[me] -= kLineWeight[mine + 1] - kLineWeight[mine];
+            if (mine + 1 == k - 1) search->threats[me]--;
+            else if (mine + 1 == k) search->threats[me]++;
+        } else if (mine == 0) {
+            search->line_score[them] += kLineWeight[theirs];
+            if (theirs == k - 1) search->threats[them]++;
+        }
+    }
+}
+
+/* One root pass to `depth` plies, trying `first` before the other moves,
+ * which are visited starting `rotate` places into the list.
+ * Returns the best score; *bestCell is only valid if the pass finished. */
+static int searchRoot(Search* search, Position* pos, const MoveList* moves, Bitboard skip,
+                      int first, int rotate, int depth, int* bestCell) {
+    int bestScore = -AI_SCORE_INF;
+
+    for (int i = -1; i < moves->count; i++) {
+        const int cell = (i < 0) ? first : moves->cells[(i + rotate) % moves->count];
+        if (cell < 0 || (i >= 0 && cell == first)) continue;
+        if (skip & ((Bitboard)1u << cell)) continue;
+
+        makeMove(search, pos, cell);
+        int score;
+        if (position_mover_wins(pos, search->has_win)) {
+            score = AI_SCORE_WIN;
+        } else if (position_empty_count(pos) == 0) {
+            score = 0;
+        } else if (bestScore == -AI_SCORE_INF) {
+            score = -negamax(search, pos, depth - 1, 1, -AI_SCORE_INF, AI_SCORE_INF);
+        } else {
+            score = -negamax(search, pos, depth - 1, 1, -bestScore - 1, -bestScore);
+            if (score > bestScore) {
+                score = -negamax(search, pos, depth - 1, 1, -AI_SCORE_INF, -bestScore);
             }
         }
-        
-        if (count > 0) {
-            const uint8_t idx = (uint8_t)(rand() % count);
-            move->row = available[idx] / n;
-            move->col = available[idx] % n;
+        unmakeMove(search, pos, cell);
+
+        if (search->stopped) break;
+        if (score > bestScore) {
+            bestScore = score;
+            *bestCell = cell;
+            if (score == AI_SCORE_WIN) break;
         }
-        return;
     }
-    
-    if (game->mode == MODE_AI_MEDIUM) {
-        Move win_move = findWinningMove(game, ai_player);
-        if (win_move.row < n && win_move.col < n) {
-            *move = win_move;
-            return;
+    return bestScore;
+}
+
+/* Exact value of every root move in turn; no depth, no evaluator. */
+static int exactRoot(Search* search, Position* pos, const MoveList* moves, Bitboard skip, int* bestCell) {
+    int bestScore = -AI_SCORE_INF;
+
+    for (int i = 0; i < moves->count; i++) {
+        const int cell = moves->cells[i];
+        if (skip & ((Bitboard)1u << cell)) continue;
+
+        position_make(pos, cell);
+        int score;
+        if (position_mover_wins(pos, search->has_win)) {
+            score = AI_SCORE_WIN;
+        } else if (position_empty_count(pos) == 0) {
+            score = 0;
+        } else {
+            score = -solveExact(search, pos, 1, -AI_SCORE_INF, -bestScore);
         }
-        
-        Move block_move = findWinningMove(game, human_player);
-        if (block_move.row < n && block_move.col < n) {
-            *move = block_move;
-            return;
+        position_unmake(pos, cell);
+
+        if (search->stopped) break;
+        if (score > bestScore) {
+            bestScore = score;
+            *bestCell = cell;
+            if (score == AI_SCORE_WIN) break;
+        }
+    }
+    return bestScore;
+}
+
+static void initSearch(Search* search, const Game* game, const Position* pos, TransTable* table,
+                       uint64_t deadline_ms, const volatile int* abort) {
+    search->has_win = bitboard_win_kernel(game->size, game->win_length);
+    search->line_count = 0;
+    search->lines = bitboard_win_masks(game->size, game->win_length, &search->line_count);
+    search->table = table;
+    search->deadline_ms = deadline_ms;
+    search->abort = abort;
+    search->nodes = 0;
+    search->tt_probes = 0;
+    search->tt_hits = 0;
+    memset(search->cutoffs, 0, sizeof(search->cutoffs));
+    search->max_ply = 0;
+    search->stopped = false;
+    memset(search->killers, AI_NO_KILLER, sizeof(search->killers));
+    memset(search->history, 0, sizeof(search->history));
+    initEval(search, game, pos);
+}
+
+static void iterateWorker(Worker* worker) {
+    AiStats* stats = worker->stats;
+    for (int depth = worker->first_depth; depth <= worker->max_depth; depth++) {
+        const uint64_t started = stats ? monotime_ms() : 0;
+        int cell = -1;
+        const int score = searchRoot(&worker->search, &worker->pos, worker->moves, worker->skip,
+                                     worker->best, worker->rotate, depth, &cell);
+        if (worker->search.stopped || cell < 0) break;
+
+        worker->best = cell;
+        worker->score = score;
+        worker->completed = depth;
+        if (stats && stats->iterations < AI_STATS_MAX_ITERATIONS) {
+            stats->iteration_ms[stats->iterations++] = (uint32_t)(monotime_ms() - started);
+        }
+        if (score > AI_SCORE_MATE_BOUND || score < -AI_SCORE_MATE_BOUND) break;
+    }
+}
+
+static void addSearchStats(AiStats* stats, const Search* search) {
+    stats->nodes += search->nodes;
+    stats->tt_probes += search->tt_probes;
+    stats->tt_hits += search->tt_hits;
+    for (int i = 0; i < AI_STATS_CUTOFF_SLOTS; i++) {
+        stats->cutoffs[i] += search->cutoffs[i];
+    }
+    if (search->max_ply > stats->max_ply) stats->max_ply = search->max_ply;
+}
+
+/* Follows the table's best moves from the root after playing `first`. */
+static void collectPv(const Game* game, Position pos, const Search* search, int first, AiStats* stats) {
+    int cell = first;
+    stats->pv_length = 0;
+    while (stats->pv_length < AI_STATS_MAX_PV) {
+        setMove(game, &stats->pv[stats->pv_length++], (uint16_t)cell);
+        position_make(&pos, cell);
+        if (position_mover_wins(&pos, search->has_win) || position_empty_count(&pos) == 0) break;
+
+        TTableHit hit;
+        if (!ttable_probe(search->table, pos.hash, &hit) || hit.move >= AI_MAX_CELLS ||
+            !(position_empty(&pos) & ((Bitboard)1u << hit.move))) {
+            break;
         }
-        
-        if (n > 2 && game->board[1][1] == PLAYER_NONE) {
-            move->row = 1;
-            move->col = 1;
+        cell = hit.move;
+    }
+}
+
+static void helperEntry(void* arg) {
+    iterateWorker((Worker*)arg);
+}
+
+void ai_get_move(Game* game, Move* move) {
+    ai_get_move_timed(game, move, 0);
+}
+
+static void chooseMove(Game* game, Move* move, uint64_t deadline_ms, AiStats* stats) {
+    MoveList moves;
+    if (game_generate_moves(game, &moves) == 0) return;
+
+    /* Same seed and position, same choice, whichever thread asks. */
+    Rng rng;
+    rng_seed(&rng, game->seed ^ game->hash);
+    
+    if (game->mode == MODE_AI_EASY) {
+        stats->source = AI_SOURCE_RANDOM;
+        setMove(game, move, moves.cells[rng_below(&rng, (uint32_t)moves.count)]);
+        return;
+    }
+
+    stats->source = AI_SOURCE_PERFECT;
+    if (game->mode == MODE_AI_HARD && perfect_best_move(game, move, NULL)) return;
+    stats->source = AI_SOURCE_ENDGAME_DB;
+    if (game->mode == MODE_AI_HARD && enddb_best_move(game, move, NULL)) return;
+    stats->source = AI_SOURCE_BOOK;
+    if (game->mode != MODE_AI_MEDIUM && book_best_move(game, move, &rng)) return;
+
+    if (game->mode == MODE_AI_MCTS) {
+        MctsBudget budget;
+        budget.deadline_ms = deadline_ms;
+        budget.playouts = g_playouts;
+        budget.threads = g_threads;
+        budget.cancel = &g_cancel;
+        stats->source = AI_SOURCE_MCTS;
+        (void)mcts_best_move(game, &budget, move, &stats->nodes);
+        return;
+    }
+    
+    Position pos;
+    const bool bitboard = game->mode == MODE_AI_HARD && position_from_game(&pos, game);
+    const bool exact = bitboard && position_empty_count(&pos) <= ai_exact_endgame_empties(game->size);
+    if (bitboard && !exact && forcedLineLikely(&pos)) {
+        DfpnBudget budget;
+        const uint64_t now = monotime_ms();
+        budget.deadline_ms = (deadline_ms > now) ? now + (deadline_ms - now) / AI_SOLVER_TIME_DIVISOR : deadline_ms;
+        budget.node_limit = deadline_ms ? 0 : AI_SOLVER_NODES;
+        budget.cancel = &g_cancel;
+        stats->source = AI_SOURCE_SOLVER;
+        if (dfpn_solve(game, &budget, move, &stats->nodes) == DFPN_WIN) {
+            stats->score = AI_SCORE_WIN;
             return;
         }
-        
-        static const uint8_t corners[4][2] = {{0, 0}, {0, 255}, {255, 0}, {255, 255}};
-        for (int i = 0; i < 4; i++) {
-            const uint8_t r = (n == 3) ? corners[i][0] : (corners[i][0] ? n - 1 : 0);
-            const uint8_t c = (n == 3) ? corners[i][1] : (corners[i][1] ? n - 1 : 0);
-            if (game->board[r][c] == PLAYER_NONE) {
-                move->row = r;
-                move->col = c;
+    }
+
+    if (bitboard) {
+        TransTable* table = sharedTable();
+        ttable_new_search(table);
+
+        const Bitboard duplicates = symmetricDuplicates(game);
+        const int empties = position_empty_count(&pos);
+
+        /* Past the threshold the exact solve is cheaper than iterating the
+         * heuristic search; if the clock runs out first, that search takes
+         * over with what is left and a table full of exact entries. */
+        if (exact) {
+            Search solver;
+            int best = -1;
+            initSearch(&solver, game, &pos, table, deadline_ms, NULL);
+            const int score = exactRoot(&solver, &pos, &moves, duplicates, &best);
+            addSearchStats(stats, &solver);
+            if (!solver.stopped && best >= 0) {
+                stats->source = AI_SOURCE_EXACT;
+                stats->depth = empties;
+                stats->score = score;
+                if (table) collectPv(game, pos, &solver, best, stats);
+                setMove(game, move, (uint16_t)best);
                 return;
             }
         }
-        
-        uint8_t available[MAX_MOVES];
-        uint8_t count = 0;
-        for (uint8_t i = 0; i < n; i++) {
-            for (uint8_t j = 0; j < n; j++) {
-                if (game->board[i][j] == PLAYER_NONE) {
-                    available[count++] = (uint8_t)(i * n + j);
-                }
-            }
+        const int maxDepth = (deadline_ms == 0 && empties > AI_MAX_DEPTH) ? AI_MAX_DEPTH : empties;
+        const int threads = (g_threads < moves.count) ? g_threads : moves.count;
+        volatile int abort = 0;
+        Worker workers[AI_MAX_THREADS];
+        Thread helpers[AI_MAX_THREADS];
+
+        /* Worker 0 runs on this thread and decides when to stop. Without a
+         * deadline it stops at AI_MAX_DEPTH; with one it deepens until time
+         * runs out. Helpers start on staggered depths and root orders so
+         * they fill the shared table with lines worker 0 has yet to reach. */
+        for (int i = 0; i < threads; i++) {
+            Worker* worker = &workers[i];
+            initSearch(&worker->search, game, &pos, table, deadline_ms, (i == 0) ? NULL : &abort);
+            worker->pos = pos;
+            worker->moves = &moves;
+            worker->skip = duplicates;
+            worker->first_depth = 1 + (i & 1);
+            worker->max_depth = maxDepth;
+            worker->rotate = i;
+            worker->best = moves.cells[0];
+            worker->score = 0;
+            worker->completed = 0;
+            worker->stats = (i == 0) ? stats : NULL;
+        }
+        for (int i = 1; i < threads; i++) {
+            (void)thread_start(&helpers[i], helperEntry, &workers[i]);
         }
-        
-        if (count > 0) {
-            const uint8_t idx = (uint8_t)(rand() % count);
-            move->row = available[idx] / n;
-            move->col = available[idx] % n;
+
+        iterateWorker(&workers[0]);
+        abort = 1;
+
+        int best = workers[0].best;
+        int score = workers[0].score;
+        int completed = workers[0].completed;
+        stats->source = AI_SOURCE_SEARCH;
+        addSearchStats(stats, &workers[0].search);
+        for (int i = 1; i < threads; i++) {
+            thread_join(&helpers[i]);
+            addSearchStats(stats, &workers[i].search);
+            if (workers[i].completed > completed) {
+                best = workers[i].best;
+                score = workers[i].score;
+                completed = workers[i].completed;
+            }
         }
+
+        stats->depth = completed;
+        stats->score = score;
+        if (table) collectPv(game, pos, &workers[0].search, best, stats);
+        setMove(game, move, (uint16_t)best);
         return;
     }
+
+    /* Medium, and hard on boards too large for the bitboard search:
+     * win, block, centre or corner, otherwise any cell. */
+    const int ranked = moves.wins + moves.blocks + moves.preferred;
+    if (ranked > 0) {
+        stats->source = AI_SOURCE_RULES;
+        setMove(game, move, moves.cells[0]);
+        return;
+    }
+    
+    stats->source = AI_SOURCE_RANDOM;
+    setMove(game, move, moves.cells[rng_below(&rng, (uint32_t)moves.count)]);
+}
+
+void ai_get_move_timed(Game* game, Move* move, uint64_t deadline_ms) {
+    if (!game || !move) return;
+    
+    if (!game_mode_is_ai(game->mode)) return;
     
-    if (game->mode == MODE_AI_HARD) {
-        int bestScore = INT_MIN;
-        
-        for (uint8_t i = 0; i < n; i++) {
-            for (uint8_t j = 0; j < n; j++) {
-                if (game->board[i][j] != PLAYER_NONE) continue;
-                
-                game->board[i][j] = ai_player;
-                
-                const Player winner = game_check_winner(game);
-                int score;
-                if (winner == ai_player) {
-                    score = 100;
-                } else if (winner == human_player) {
-                    score = -100;
-                } else if (game_is_board_full(game)) {
-                    score = 0;
+    move->row = game->size;
+    move->col = game->size;
+
+    /* Filled off to the side so a reader never sees a half-written search. */
+    AiStats stats;
+    memset(&stats, 0, sizeof(stats));
+    const uint64_t started = monotime_ms();
+    chooseMove(game, move, deadline_ms, &stats);
+
+    stats.elapsed_ms = monotime_ms() - started;
+    stats.nodes_per_sec = stats.elapsed_ms ? stats.nodes * 1000u / stats.elapsed_ms : 0;
+    if (stats.pv_length == 0 && move->row < game->size) {
+        stats.pv[0] = *move;
+        stats.pv_length = 1;
+    }
+    if (move->row >= game->size) stats.source = AI_SOURCE_NONE;
+    g_stats = stats;
+}
+
+static void requestEntry(void* arg) {
+    AsyncRequest* request = (AsyncRequest*)arg;
+    if (request->analyze) {
+        request->analysis_count = analyzeMoves(&request->game, request->deadline_ms, request->analysis, MAX_MOVES);
+    } else {
+        ai_get_move_timed(&request->game, &request->move, request->deadline_ms);
+    }
+    request->done = 1;
+}
+
+static void finishRequest(Move* move) {
+    thread_join(&g_request.thread);
+    g_request.active = false;
+    if (move) *move = g_request.move;
+}
+
+/* Runs on the request thread with the opponent to move. MCTS just grows
+ * its tree over every reply, which the next search re-roots onto. The
+ * alpha-beta search predicts one reply and answers it ahead of time,
+ * filling the shared table either way. */
+static void ponderEntry(void* arg) {
+    AsyncRequest* request = (AsyncRequest*)arg;
+    Game game = request->game;
+
+    if (game.mode == MODE_AI_MCTS) {
+        ai_get_move_timed(&game, &request->move, request->deadline_ms);
+        request->done = 1;
+        return;
+    }
+
+    Move predicted;
+    ai_get_move_timed(&game, &predicted, monotime_ms() + AI_PONDER_PREDICT_MS);
+    if (!g_cancel && predicted.row < game.size && predicted.col < game.size &&
+        game_make_move(&game, predicted.row, predicted.col) && game.state == GAME_STATE_PLAYING) {
+        const uint64_t started = monotime_ms();
+        ai_get_move_timed(&game, &request->move, request->deadline_ms);
+        g_ponder.hash = game.hash;
+        g_ponder.move = request->move;
+        g_ponder.elapsed_ms = monotime_ms() - started;
+        g_ponder.finished = !g_cancel;
+        g_ponder.valid = request->move.row < game.size;
+    }
+    request->done = 1;
+}
+
+static bool startRequest(const Game* game, uint64_t deadline_ms, RequestKind kind) {
+    const bool ponder = kind == REQUEST_PONDER;
+    g_request.game = *game;
+    g_request.move.row = game->size;
+    g_request.move.col = game->size;
+    g_request.analysis_count = 0;
+    g_request.deadline_ms = deadline_ms;
+    g_request.done = 0;
+    g_request.active = true;
+    g_request.ponder = ponder;
+    g_request.analyze = kind == REQUEST_ANALYSIS;
+    if (!thread_start(&g_request.thread, ponder ? ponderEntry : requestEntry, &g_request)) {
+        /* Pondering inline would block the caller for the whole limit. */
+        if (ponder) {
+            g_request.active = false;
+            return false;
+        }
+        requestEntry(&g_request);
+    }
+    return true;
+}
+
+bool ai_request_move(const Game* game, uint64_t deadline_ms) {
+    if (!game || !game_mode_is_ai(game->mode)) return false;
+    ai_cancel();
+
+    /* A ponder hit that already thought as long as this move may take
+     * (or ran to the end) is answered without searching again. */
+    const bool hit = g_ponder.valid && g_ponder.hash == game->hash;
+    g_ponder.valid = false;
+    if (hit && (g_ponder.finished ||
+                (deadline_ms != 0 && monotime_ms() + g_ponder.elapsed_ms >= deadline_ms))) {
+        g_request.game = *game;
+        g_request.move = g_ponder.move;
+        g_request.deadline_ms = deadline_ms;
+        g_request.done = 1;
+        g_request.active = true;
+        g_request.ponder = false;
+        g_request.analyze = false;
+        g_stats.ponder_hit = true;
+        return true;
+    }
+    return startRequest(game, deadline_ms, REQUEST_MOVE);
+}
+
+bool ai_start_ponder(const Game* game) {
+    if (!game || game->state != GAME_STATE_PLAYING) return false;
+    if (game->mode != MODE_AI_HARD && game->mode != MODE_AI_MCTS) return false;
+    if (g_request.active && g_request.ponder && g_request.game.hash == game->hash &&
+        g_request.game.history_count == game->history_count) {
+        return true;
+    }
+    ai_cancel();
+    g_ponder.valid = false;
+    return startRequest(game, monotime_ms() + AI_PONDER_LIMIT_MS, REQUEST_PONDER);
+}
+
+bool ai_poll_result(Move* move) {
+    if (!g_request.active || g_request.ponder || g_request.analyze || !g_request.done) return false;
+    finishRequest(move);
+    return true;
+}
+
+bool ai_wait_result(Move* move) {
+    if (!g_request.active || g_request.ponder || g_request.analyze) return false;
+    finishRequest(move);
+    return true;
+}
+
+bool ai_request_analysis(const Game* game, uint64_t deadline_ms) {
+    if (!game || game->state != GAME_STATE_PLAYING) return false;
+    ai_cancel();
+    return startRequest(game, deadline_ms, REQUEST_ANALYSIS);
+}
+
+bool ai_poll_analysis(AiMoveAnalysis* results, int max, int* count) {
+    if (!g_request.active || !g_request.analyze || !g_request.done) return false;
+    finishRequest(NULL);
+    const int n = (g_request.analysis_count < max) ? g_request.analysis_count : max;
+    if (results && n > 0) memcpy(results, g_request.analysis, (size_t)n * sizeof(*results));
+    if (count) *count = (n > 0) ? n : 0;
+    return true;
+}
+
+void ai_cancel(void) {
+    if (!g_request.active) return;
+    g_cancel = 1;
+    thread_join(&g_request.thread);
+    g_request.active = false;
+    g_cancel = 0;
+}
+
+bool ai_is_thinking(void) {
+    return g_request.active && !g_request.ponder && !g_request.done;
+}
+
+bool ai_is_pondering(void) {
+    return g_request.active && g_request.ponder;
+}
+
+/* Each stone in a run counts four times the one before, capped well
+ * inside the decided range. */
+static int runWeight(int run) {
+    return 1 << (2 * ((run < AI_RUN_WEIGHT_CAP) ? run : AI_RUN_WEIGHT_CAP));
+}
+
+/* Boards beyond the bitboard search: wins and forced blocks are certain,
+ * the rest are rated by the longest run each move makes or breaks. */
+static void rateByRules(const Game* game, const MoveList* moves, AiMoveAnalysis* results, int count) {
+    const int side = game->current_player - 1;
+    const int forced = moves->wins + moves->blocks;
+
+    for (int i = 0; i < count; i++) {
+        AiMoveAnalysis* result = &results[i];
+        if (i < moves->wins) {
+            result->score = AI_SCORE_WIN;
+            result->verdict = AI_VERDICT_WIN;
+        } else if (moves->wins == 0 && (moves->blocks > 1 || (moves->blocks == 1 && i >= forced))) {
+            /* Two open winning cells cannot both be covered. */
+            result->score = -(AI_SCORE_WIN - 1);
+            result->verdict = AI_VERDICT_LOSS;
+        } else {
+            const int mine = lineboard_run_at(&game->lines, side, game->size, result->move.row, result->move.col, NULL);
+            const int theirs = lineboard_run_at(&game->lines, side ^ 1, game->size, result->move.row, result->move.col, NULL);
+            result->score = 2 * runWeight(mine) + runWeight(theirs);
+        }
+    }
+}
+
+static int analyzeMoves(const Game* game, uint64_t deadline_ms, AiMoveAnalysis* results, int max) {
+    if (!game || !results || max <= 0) return 0;
+
+    MoveList moves;
+    if (game_generate_moves(game, &moves) == 0) return 0;
+
+    memset(&g_stats, 0, sizeof(g_stats));
+    const uint64_t started = monotime_ms();
+    const int count = (moves.count < max) ? moves.count : max;
+    int cells[MAX_MOVES];
+    for (int i = 0; i < count; i++) {
+        cells[i] = moves.cells[i];
+        results[i].score = 0;
+        results[i].verdict = AI_VERDICT_UNKNOWN;
+        results[i].depth = 0;
+        results[i].plies = 0;
+        setMove(game, &results[i].move, moves.cells[i]);
+    }
+
+    Position pos;
+    if (!position_from_game(&pos, game)) {
+        rateByRules(game, &moves, results, count);
+        g_stats.source = AI_SOURCE_RULES;
+    } else {
+        TransTable* table = sharedTable();
+        ttable_new_search(table);
+
+        const int empties = position_empty_count(&pos);
+        const int maxDepth = (deadline_ms == 0 && empties > AI_MAX_DEPTH) ? AI_MAX_DEPTH : empties;
+        int iteration[MAX_MOVES];
+        int completed = 0;
+
+        /* Siblings share the table, so each later move starts from what
+         * the earlier ones proved about the positions they have in common.
+         * If the clock runs out first, the search below takes over with a
+         * fresh stop flag and the exact entries already stored. */
+        if (empties <= ai_exact_endgame_empties(game->size)) {
+            Search solver;
+            initSearch(&solver, game, &pos, table, deadline_ms, NULL);
+            for (int i = 0; i < count && !solver.stopped; i++) {
+                position_make(&pos, cells[i]);
+                if (position_mover_wins(&pos, solver.has_win)) {
+                    iteration[i] = AI_SCORE_WIN;
+                } else if (position_empty_count(&pos) == 0) {
+                    iteration[i] = 0;
                 } else {
-                    score = -minimax(game, 1, ai_player, human_player, INT_MIN, INT_MAX);
+                    iteration[i] = -solveExact(&solver, &pos, 1, -AI_SCORE_INF, AI_SCORE_INF);
                 }
-                
-                game->board[i][j] = PLAYER_NONE;
-                
-                if (score > bestScore) {
-                    bestScore = score;
-                    move->row = i;
-                    move->col = j;
-                    if (score == 100) return;
+                position_unmake(&pos, cells[i]);
+            }
+            addSearchStats(&g_stats, &solver);
+            if (!solver.stopped) {
+                for (int i = 0; i < count; i++) {
+                    results[i].score = iteration[i];
                 }
+                completed = empties;
             }
         }
+
+        Search search;
+        initSearch(&search, game, &pos, table, deadline_ms, NULL);
+
+        /* Every move gets a full window so its score is exact, not a bound. */
+        for (int depth = 1; depth <= maxDepth && completed < empties; depth++) {
+            bool decided = true;
+            for (int i = 0; i < count && !search.stopped; i++) {
+                makeMove(&search, &pos, cells[i]);
+                if (position_mover_wins(&pos, search.has_win)) {
+                    iteration[i] = AI_SCORE_WIN;
+                } else if (position_empty_count(&pos) == 0) {
+                    iteration[i] = 0;
+                } else {
+                    iteration[i] = -negamax(&search, &pos, depth - 1, 1, -AI_SCORE_INF, AI_SCORE_INF);
+                }
+                unmakeMove(&search, &pos, cells[i]);
+                if (iteration[i] <= AI_SCORE_MATE_BOUND && iteration[i] >= -AI_SCORE_MATE_BOUND) decided = false;
+            }
+            if (search.stopped) break;
+
+            for (int i = 0; i < count; i++) {
+                results[i].score = iteration[i];
+            }
+            completed = depth;
+            if (decided) break;
+        }
+
+        /* Searched to the last cell, a score inside the bounds is a draw. */
+        for (int i = 0; i < count; i++) {
+            const int score = results[i].score;
+            results[i].depth = completed;
+            if (score > AI_SCORE_MATE_BOUND) results[i].verdict = AI_VERDICT_WIN;
+            else if (score < -AI_SCORE_MATE_BOUND) results[i].verdict = AI_VERDICT_LOSS;
+            else if (completed >= empties) results[i].verdict = AI_VERDICT_DRAW;
+        }
+
+        g_stats.source = (completed >= empties && empties <= ai_exact_endgame_empties(game->size)) ?
+                         AI_SOURCE_EXACT : AI_SOURCE_SEARCH;
+        g_stats.depth = completed;
+        addSearchStats(&g_stats, &search);
     }
+
+    for (int i = 0; i < count; i++) {
+        const int score = (results[i].score < 0) ? -results[i].score : results[i].score;
+        if (results[i].verdict == AI_VERDICT_WIN || results[i].verdict == AI_VERDICT_LOSS) {
+            results[i].plies = AI_SCORE_WIN - score + 1;
+        }
+    }
+
+    for (int i = 1; i < count; i++) {
+        const AiMoveAnalysis current = results[i];
+        int j = i;
+        while (j > 0 && results[j - 1].score < current.score) {
+            results[j] = results[j - 1];
+            j--;
+        }
+        results[j] = current;
+    }
+
+    g_stats.elapsed_ms = monotime_ms() - started;
+    g_stats.nodes_per_sec = g_stats.elapsed_ms ? g_stats.nodes * 1000u / g_stats.elapsed_ms : 0;
+    if (count > 0) {
+        g_stats.score = results[0].score;
+        g_stats.pv[0] = results[0].move;
+        g_stats.pv_length = 1;
+    }
+    return count;
 }
 
-static Move findWinningMove(Game* game, Player player) {
-    Move move = {MAX_BOARD_SIZE, MAX_BOARD_SIZE, PLAYER_NONE};
-    const uint8_t n = game->size;
-    
-    for (uint8_t i = 0; i < n; i++) {
-        for (uint8_t j = 0; j < n; j++) {
-            if (game->board[i][j] != PLAYER_NONE) continue;
-            
-            game->board[i][j] = player;
-            const Player winner = game_check_winner(game);
-            game->board[i][j] = PLAYER_NONE;
-            
-            if (winner == player) {
-                move.row = i;
-                move.col = j;
-                return move;
-            }
+int ai_analyze(const Game* game, AiMoveAnalysis* results, int max) {
+    return ai_analyze_timed(game, 0, results, max);
+}
+
+int ai_analyze_timed(const Game* game, uint64_t deadline_ms, AiMoveAnalysis* results, int max) {
+    ai_cancel();
+    return analyzeMoves(game, deadline_ms, results, max);
+}
+
+int ai_score_moves(Game* game, uint64_t deadline_ms, AiMoveScore* scores, int max) {
+    if (!scores || max <= 0) return 0;
+
+    AiMoveAnalysis results[MAX_MOVES];
+    const int count = analyzeMoves(game, deadline_ms, results, (max < MAX_MOVES) ? max : MAX_MOVES);
+    for (int i = 0; i < count; i++) {
+        scores[i].move = results[i].move;
+        scores[i].score = results[i].score;
+    }
+    return count;
+}
+
+/* Win scores shrink with distance from the root; the table stores them
+ * relative to the node so they stay valid from any other root. */
+static int scoreToTable(int score, int ply) {
+    if (score > AI_SCORE_MATE_BOUND) return score + ply;
+    if (score < -AI_SCORE_MATE_BOUND) return score - ply;
+    return score;
+}
+
+static int scoreFromTable(int score, int ply) {
+    if (score > AI_SCORE_MATE_BOUND) return score - ply;
+    if (score < -AI_SCORE_MATE_BOUND) return score + ply;
+    return score;
+}
+
+/* Empty cells that would complete a line for `stones`. */
+static Bitboard threatCells(const Search* search, Bitboard stones, Bitboard empty) {
+    Bitboard threats = 0;
+    for (int i = 0; i < search->line_count; i++) {
+        const Bitboard rest = search->lines[i].mask & ~stones;
+        if ((rest & (rest - 1)) == 0) {
+            threats |= rest;
         }
     }
-    
-    return move;
+    return threats & empty;
 }
 
-static int minimax(Game* game, int depth, Player ai_player, Player human_player, int alpha, int beta) {
-    const uint8_t n = game->size;
-    
-    const Player winner = game_check_winner(game);
-    if (winner == ai_player) return 100 - depth;
-    if (winner == human_player) return -100 + depth;
-    if (game_is_board_full(game)) return 0;
-    
-    if (depth >= 6) return 0;
-    
-    int maxScore = INT_MIN;
-    
-    for (uint8_t i = 0; i < n; i++) {
-        for (uint8_t j = 0; j < n; j++) {
-            if (game->board[i][j] != PLAYER_NONE) continue;
-            
-            game->board[i][j] = ai_player;
-            
-            const Player w = game_check_winner(game);
-            int score;
-            if (w == ai_player) {
-                score = 100 - depth;
-            } else if (w == human_player) {
-                score = -100 + depth;
-            } else if (game_is_board_full(game)) {
-                score = 0;
-            } else {
-                score = -minimax(game, depth + 1, ai_player, human_player, -beta, -alpha);
-            }
-            
-            game->board[i][j] = PLAYER_NONE;
-            
-            if (score > maxScore) {
-                maxScore = score;
-            }
-            if (score > alpha) {
-                alpha = score;
+/* Empty cells that would leave `mine` one stone short on an open line. */
+static Bitboard threatMakers(const Search* search, Bitboard mine, Bitboard theirs, Bitboard empty) {
+    Bitboard cells = 0;
+    for (int i = 0; i < search->line_count; i++) {
+        const Bitboard mask = search->lines[i].mask;
+        if ((mask & theirs) == 0 && bitboard_popcount(mask & mine) + 2 == search->win_length) {
+            cells |= mask;
+        }
+    }
+    return cells & empty;
+}
+
+static void rememberCutoff(Search* search, int side, int ply, int cell, int depth) {
+    uint8_t* killers = search->killers[ply];
+    if (killers[0] != cell) {
+        killers[1] = killers[0];
+        killers[0] = (uint8_t)cell;
+    }
+
+    uint32_t* history = search->history[side];
+    history[cell] += (uint32_t)(depth * depth);
+    if (history[cell] >= AI_HISTORY_LIMIT) {
+        for (int i = 0; i < AI_MAX_CELLS; i++) {
+            history[i] >>= 1;
+        }
+    }
+}
+
+/* Static score for `side` to move at the horizon. */
+static int evaluate(const Search* search, Player side) {
+    const int me = side - 1;
+    int score = search->line_score[me] - search->line_score[me ^ 1];
+    if (score > AI_EVAL_LIMIT) score = AI_EVAL_LIMIT;
+    if (score < -AI_EVAL_LIMIT) score = -AI_EVAL_LIMIT;
+    return score;
+}
+
+/* Principal variation search: the first move gets the full window, the
+ * rest a null window around alpha that is re-searched only when a move
+ * proves better. Moves come TT move, blocks, killers, then history. */
+static int negamax(Search* search, Position* pos, int depth, int ply, int alpha, int beta) {
+    if (search->stopped) return 0;
+    if ((++search->nodes & AI_CLOCK_CHECK_MASK) == 0 &&
+        (g_cancel || (search->abort && *search->abort) ||
+         (search->deadline_ms != 0 && monotime_ms() >= search->deadline_ms))) {
+        search->stopped = true;
+        return 0;
+    }
+    if (ply > search->max_ply) search->max_ply = ply;
+
+    const Player side = position_side(pos);
+    const Player other = (side == PLAYER_X) ? PLAYER_O : PLAYER_X;
+    const Bitboard empty = position_empty(pos);
+
+    /* A winning move is always best, so there is nothing to search; two
+     * different winning cells for the opponent cannot both be blocked. */
+    if (search->threats[side - 1]) {
+        return AI_SCORE_WIN - ply;
+    }
+    if (search->threats[other - 1] >= 2 &&
+        bitboard_popcount(threatCells(search, position_stones(pos, other), empty)) >= 2) {
+        return -(AI_SCORE_WIN - ply - 1);
+    }
+    if (depth <= 0) return evaluate(search, side);
+
+    const int alphaStart = alpha;
+    int ttMove = -1;
+
+    TTableHit hit;
+    search->tt_probes++;
+    if (ttable_probe(search->table, pos->hash, &hit)) {
+        search->tt_hits++;
+        if (hit.depth >= depth) {
+            const int stored = scoreFromTable(hit.score, ply);
+            if (hit.bound == TTABLE_BOUND_EXACT) return stored;
+            if (hit.bound == TTABLE_BOUND_LOWER && stored >= beta) return stored;
+            if (hit.bound == TTABLE_BOUND_UPPER && stored <= alpha) return stored;
+        }
+        if (hit.move < AI_MAX_CELLS && (empty & ((Bitboard)1u << hit.move))) {
+            ttMove = hit.move;
+        }
+    }
+
+    const Bitboard blocks = search->threats[other - 1] ? threatCells(search, position_stones(pos, other), empty) : 0;
+    const uint8_t* killers = search->killers[ply];
+    const uint32_t* history = search->history[side - 1];
+    uint8_t cells[AI_MAX_CELLS];
+    uint32_t keys[AI_MAX_CELLS];
+    int count = 0;
+
+    for (Bitboard rest = empty; rest; rest &= rest - 1) {
+        const int cell = bitboard_lsb(rest);
+        uint32_t key = history[cell];
+        if (cell == ttMove) {
+            key = AI_ORDER_TT;
+        } else if (blocks & ((Bitboard)1u << cell)) {
+            key = AI_ORDER_BLOCK;
+        } else if (cell == killers[0]) {
+            key = AI_ORDER_KILLER + 1;
+        } else if (cell == killers[1]) {
+            key = AI_ORDER_KILLER;
+        }
+        cells[count] = (uint8_t)cell;
+        keys[count++] = key;
+    }
+
+    int maxScore = -AI_SCORE_INF;
+    int bestCell = TTABLE_NO_MOVE;
+
+    for (int i = 0; i < count; i++) {
+        int pick = i;
+        for (int j = i + 1; j < count; j++) {
+            if (keys[j] > keys[pick]) pick = j;
+        }
+        const int cell = cells[pick];
+        cells[pick] = cells[i];
+        keys[pick] = keys[i];
+
+        makeMove(search, pos, cell);
+        int score;
+        if (position_empty_count(pos) == 0) {
+            score = 0;
+        } else if (i == 0) {
+            score = -negamax(search, pos, depth - 1, ply + 1, -beta, -alpha);
+        } else {
+            score = -negamax(search, pos, depth - 1, ply + 1, -alpha - 1, -alpha);
+            if (score > alpha && score < beta) {
+                score = -negamax(search, pos, depth - 1, ply + 1, -beta, -alpha);
             }
-            if (beta <= alpha) {
-                return maxScore;
+        }
+        unmakeMove(search, pos, cell);
+
+        if (search->stopped) return 0;
+        if (score > maxScore) {
+            maxScore = score;
+            bestCell = cell;
+        }
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            search->cutoffs[(i < AI_STATS_CUTOFF_SLOTS) ? i : AI_STATS_CUTOFF_SLOTS - 1]++;
+            if (!(blocks & ((Bitboard)1u << cell))) {
+                rememberCutoff(search, side - 1, ply, cell, depth);
             }
+            break;
         }
     }
-    
+
+    const TTableBound bound = (maxScore <= alphaStart) ? TTABLE_BOUND_UPPER :
+                              (maxScore >= beta) ? TTABLE_BOUND_LOWER : TTABLE_BOUND_EXACT;
+    ttable_store(search->table, pos->hash, depth, bound, scoreToTable(maxScore, ply), (uint16_t)bestCell);
     return maxScore;
 }
+
+/* Endgame alpha-beta to the end of the game. Scores are exact (a win,
+ * a loss or 0), so they go in the table at the full remaining depth and
+ * serve the heuristic search as well. Wins and forced blocks come from
+ * the line masks; everything else is a plain walk over the empty bits. */
+static int solveExact(Search* search, Position* pos, int ply, int alpha, int beta) {
+    if (search->stopped) return 0;
+    if ((++search->nodes & AI_CLOCK_CHECK_MASK) == 0 &&
+        (g_cancel || (search->abort && *search->abort) ||
+         (search->deadline_ms != 0 && monotime_ms() >= search->deadline_ms))) {
+        search->stopped = true;
+        return 0;
+    }
+    if (ply > search->max_ply) search->max_ply = ply;
+
+    const Player side = position_side(pos);
+    const Player other = (side == PLAYER_X) ? PLAYER_O : PLAYER_X;
+    const Bitboard empty = position_empty(pos);
+
+    if (threatCells(search, position_stones(pos, side), empty)) {
+        return AI_SCORE_WIN - ply;
+    }
+    const Bitboard blocks = threatCells(search, position_stones(pos, other), empty);
+    if (bitboard_popcount(blocks) >= 2) {
+        return -(AI_SCORE_WIN - ply - 1);
+    }
+
+    const int depth = position_empty_count(pos);
+    const int alphaStart = alpha;
+    int ttMove = -1;
+
+    TTableHit hit;
+    search->tt_probes++;
+    if (ttable_probe(search->table, pos->hash, &hit)) {
+        search->tt_hits++;
+        if (hit.depth >= depth) {
+            const int stored = scoreFromTable(hit.score, ply);
+            if (hit.bound == TTABLE_BOUND_EXACT) return stored;
+            if (hit.bound == TTABLE_BOUND_LOWER && stored >= beta) return stored;
+            if (hit.bound == TTABLE_BOUND_UPPER && stored <= alpha) return stored;
+        }
+        if (hit.move < AI_MAX_CELLS && (empty & ((Bitboard)1u << hit.move))) {
+            ttMove = hit.move;
+        }
+    }
+
+    /* A single threat leaves one legal reply. Otherwise the table move
+     * goes first, then moves that make a threat, then the rest. */
+    Bitboard rest = blocks ? blocks : empty;
+    Bitboard forcing = blocks ? 0 : threatMakers(search, position_stones(pos, side), position_stones(pos, other), empty);
+    uint8_t cells[AI_MAX_CELLS];
+    int count = 0;
+    if (ttMove >= 0 && (rest & ((Bitboard)1u << ttMove))) {
+        cells[count++] = (uint8_t)ttMove;
+        rest &= ~((Bitboard)1u << ttMove);
+        forcing &= ~((Bitboard)1u << ttMove);
+    }
+    for (rest &= ~forcing; forcing; forcing &= forcing - 1) {
+        cells[count++] = (uint8_t)bitboard_lsb(forcing);
+    }
+    for (; rest; rest &= rest - 1) {
+        cells[count++] = (uint8_t)bitboard_lsb(rest);
+    }
+
+    int maxScore = -AI_SCORE_INF;
+    int bestCell = TTABLE_NO_MOVE;
+
+    for (int i = 0; i < count; i++) {
+        const int cell = cells[i];
+        position_make(pos, cell);
+        const int score = (position_empty_count(pos) == 0) ? 0 : -solveExact(search, pos, ply + 1, -beta, -alpha);
+        position_unmake(pos, cell);
+
+        if (search->stopped) return 0;
+        if (score > maxScore) {
+            maxScore = score;
+            bestCell = cell;
+        }
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            search->cutoffs[(i < AI_STATS_CUTOFF_SLOTS) ? i : AI_STATS_CUTOFF_SLOTS - 1]++;
+            break;
+        }
+    }
+
+    const TTableBound bound = (maxScore <= alphaStart) ? TTABLE_BOUND_UPPER :
+                              (maxScore >= beta) ? TTABLE_BOUND_LOWER : TTABLE_BOUND_EXACT;
+    ttable_store(search->table, pos->hash, depth, bound, scoreToTable(maxScore, ply), (uint16_t)bestCell);
+    return maxScore;
+}
+
+/* Two or more lines one stone short of a threat, for either side, is
+ * where forced sequences start and the solver tends to pay off. */
+static bool forcedLineLikely(const Position* pos) {
+    const uint8_t k = position_win_length(pos);
+    const Bitboard x = position_stones(pos, PLAYER_X);
+    const Bitboard o = position_stones(pos, PLAYER_O);
+    int count = 0;
+    const WinMask* lines = bitboard_win_masks(position_size(pos), k, &count);
+
+    int open = 0;
+    for (int i = 0; i < count; i++) {
+        const Bitboard mask = lines[i].mask;
+        if (((mask & o) == 0 && bitboard_popcount(mask & x) + 2 >= k) ||
+            ((mask & x) == 0 && bitboard_popcount(mask & o) + 2 >= k)) {
+            if (++open >= 2) return true;
+        }
+    }
+    return false;
+}
+
+/* Cells whose move mirrors a lower-numbered cell under a symmetry of the
+ * current board; searching them again cannot change the result. */
+static Bitboard symmetricDuplicates(const Game* game) {
+    const uint8_t n = game->size;
+    const int cells = n * n;
+    Bitboard duplicates = 0;
+
+    for (int t = SYMMETRY_IDENTITY + 1; t < SYMMETRY_COUNT; t++) {
+        const uint16_t* map = symmetry_cell_map(n, (Symmetry)t);
+        bool invariant = true;
+        for (int cell = 0; cell < cells && invariant; cell++) {
+            invariant = game->board[cell / n][cell % n] == game->board[map[cell] / n][map[cell] % n];
+        }
+        if (!invariant) continue;
+
+        for (int cell = 0; cell < cells; cell++) {
+            if (map[cell] < cell) {
+                duplicates |= (Bitboard)1u << cell;
+            }
+        }
+    }
+    return duplicates;
+}
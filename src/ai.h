@@ -2,7 +2,133 @@
 #define AI_H
 
 #include "game.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define AI_DEFAULT_HASH_MB 16
+#define AI_DEFAULT_TIME_MS 1000
+#define AI_MAX_THREADS 64
+#define AI_SCORE_DECIDED 5000
+#define AI_EXACT_AUTO (-1)
+#define AI_STATS_CUTOFF_SLOTS 8
+#define AI_STATS_MAX_ITERATIONS 32
+#define AI_STATS_MAX_PV 16
+
+typedef enum {
+    AI_SOURCE_NONE,
+    AI_SOURCE_RANDOM,
+    AI_SOURCE_RULES,
+    AI_SOURCE_PERFECT,
+    AI_SOURCE_ENDGAME_DB,
+    AI_SOURCE_BOOK,
+    AI_SOURCE_SEARCH,
+    AI_SOURCE_MCTS,
+    AI_SOURCE_SOLVER,
+    AI_SOURCE_EXACT
+} AiSource;
+
+/* What the last search did, summed over all threads where that applies.
+ * Iteration times and the score come from the main search thread. */
+typedef struct {
+    AiSource source;
+    bool ponder_hit;            /* answered from a ponder without searching */
+    uint64_t nodes;             /* playouts for MCTS */
+    uint64_t elapsed_ms;
+    uint64_t nodes_per_sec;
+    int depth;                  /* deepest completed iteration */
+    int max_ply;                /* deepest node visited */
+    int score;                  /* mover's view, as in AiMoveScore */
+    uint64_t tt_probes;
+    uint64_t tt_hits;
+    uint64_t cutoffs[AI_STATS_CUTOFF_SLOTS];  /* by index of the cutting move; the last slot counts the rest */
+    int iterations;
+    uint32_t iteration_ms[AI_STATS_MAX_ITERATIONS];
+    int pv_length;
+    Move pv[AI_STATS_MAX_PV];
+} AiStats;
 
 void ai_get_move(Game* game, Move* move);
+/* deadline_ms is absolute on monotime_ms(); 0 searches to the fixed depth cap. */
+void ai_get_move_timed(Game* game, Move* move, uint64_t deadline_ms);
+void ai_set_hash_size(size_t megabytes);
+void ai_set_threads(int threads);
+/* Monte Carlo playouts per move in MODE_AI_MCTS, 0 to rely on the deadline. */
+void ai_set_playouts(int playouts);
+/* Proof-number solver table for hard mode, 0 to turn the solver off. */
+void ai_set_solver_size(size_t megabytes);
+/* Hard mode solves exactly once this many cells or fewer are empty;
+ * AI_EXACT_AUTO picks the tuned count for the board size, 0 turns it off. */
+void ai_set_exact_endgame(int empties);
+int ai_exact_endgame_empties(uint8_t size);
+void ai_clear_hash(void);
+/* Nodes (playouts for MCTS) visited by the last search, summed over all threads. */
+uint64_t ai_last_node_count(void);
+/* Read after the search has finished, never while a request or ponder runs. */
+void ai_last_stats(AiStats* stats);
+const char* ai_source_name(AiSource source);
+bool ai_load_endgame_db(const char* path);
+
+/*
+ * One background search at a time. ai_request_move() copies the game and
+ * starts thinking on a worker thread (cancelling any search in progress);
+ * ai_poll_result() returns true once, with the move, when it is done.
+ * ai_cancel() stops the search and discards its answer.
+ */
+bool ai_request_move(const Game* game, uint64_t deadline_ms);
+bool ai_poll_result(Move* move);
+bool ai_wait_result(Move* move);
+void ai_cancel(void);
+bool ai_is_thinking(void);
+
+/*
+ * Thinks on the opponent's time: call with the opponent to move in a hard
+ * or expert game. The search runs in the background until the next
+ * ai_request_move() or ai_cancel(); if the opponent plays the predicted
+ * reply and the ponder already used the move's budget the answer is
+ * immediate, otherwise the search resumes on the warmed table or tree.
+ */
+bool ai_start_ponder(const Game* game);
+bool ai_is_pondering(void);
+bool ai_load_opening_book(const char* path);
+
+typedef struct {
+    Move move;
+    int score;
+} AiMoveScore;
+
+typedef enum {
+    AI_VERDICT_UNKNOWN,
+    AI_VERDICT_WIN,
+    AI_VERDICT_DRAW,
+    AI_VERDICT_LOSS
+} AiVerdict;
+
+typedef struct {
+    Move move;
+    int score;          /* as in AiMoveScore */
+    AiVerdict verdict;  /* proven result for the mover, or unknown */
+    int depth;          /* plies searched, 0 when rated by rules */
+    int plies;          /* to the end of a proven win or loss, this move included */
+} AiMoveAnalysis;
+
+/* Searches every legal move with a full window and fills `scores` best
+ * first. Scores are from the mover's side. Beyond +-AI_SCORE_DECIDED they
+ * are forced wins or losses (larger magnitude is sooner); below it they
+ * are the static evaluation at the horizon, 0 for a draw. Boards too
+ * large for the bitboard search are rated by rules: wins, forced blocks,
+ * then the runs each move extends or cuts. */
+int ai_score_moves(Game* game, uint64_t deadline_ms, AiMoveScore* scores, int max);
+/* The same scores for hints and review, with each move's proven result.
+ * All moves share one search and its table; late positions are solved
+ * exactly. Cancels any request or ponder first. ai_analyze searches to
+ * the fixed depth, ai_analyze_timed until the deadline. */
+int ai_analyze(const Game* game, AiMoveAnalysis* results, int max);
+int ai_analyze_timed(const Game* game, uint64_t deadline_ms, AiMoveAnalysis* results, int max);
+/* The same analysis as a background request, in the slot ai_request_move()
+ * uses (cancelling any search in progress). ai_poll_analysis() returns true
+ * once, with up to `max` results, when it is done. */
+bool ai_request_analysis(const Game* game, uint64_t deadline_ms);
+bool ai_poll_analysis(AiMoveAnalysis* results, int max, int* count);
 
 #endif
@@ -0,0 +1,164 @@
+#include "bitboard.h"
+#include <stddef.h>
+
+#define BITBOARD_MIN_SIZE 3
+#define BITBOARD_SIZE_COUNT (BITBOARD_MAX_SIZE - BITBOARD_MIN_SIZE + 1)
+#define BITBOARD_CELLS (BITBOARD_MAX_SIZE * BITBOARD_MAX_SIZE)
+
+typedef struct {
+    WinMask masks[BITBOARD_MAX_WIN_MASKS];
+    int count;
+    uint8_t cell_masks[BITBOARD_CELLS][BITBOARD_MAX_CELL_MASKS];
+    uint8_t cell_mask_count[BITBOARD_CELLS];
+} WinTable;
+
+/* Indexed by [size - 3][win_length - 3]; only win_length <= size is filled. */
+static WinTable g_tables[BITBOARD_SIZE_COUNT][BITBOARD_SIZE_COUNT];
+static bool g_tables_ready = false;
+
+/* Cells where a run of win_length can start, per direction: right, down,
+ * down-right, down-left. Indexed like g_tables. */
+static const Bitboard g_run_starts[BITBOARD_SIZE_COUNT][BITBOARD_SIZE_COUNT][4] = {
+    {
+        {0x0000049u, 0x0000007u, 0x0000001u, 0x0000004u},
+        {0, 0, 0, 0},
+        {0, 0, 0, 0}
+    },
+    {
+        {0x0003333u, 0x00000FFu, 0x0000033u, 0x00000CCu},
+        {0x0001111u, 0x000000Fu, 0x0000001u, 0x0000008u},
+        {0, 0, 0, 0}
+    },
+    {
+        {0x0739CE7u, 0x0007FFFu, 0x0001CE7u, 0x000739Cu},
+        {0x0318C63u, 0x00003FFu, 0x0000063u, 0x0000318u},
+        {0x0108421u, 0x000001Fu, 0x0000001u, 0x0000010u}
+    }
+};
+
+static inline Bitboard run_starts(Bitboard stones, Bitboard starts, int shift, int length) {
+    Bitboard runs = stones & starts;
+    for (int i = 1; i < length; i++) {
+        runs &= stones >> (i * shift);
+    }
+    return runs;
+}
+
+/* One kernel per (size, win_length) so shifts and loop bounds are constants. */
+#define DEFINE_WIN_KERNEL(N, K)                                              \
+    static bool has_win_##N##_##K(Bitboard stones) {                         \
+        const Bitboard* starts = g_run_starts[(N) - 3][(K) - 3];             \
+        return (run_starts(stones, starts[0], 1, (K)) |                      \
+                run_starts(stones, starts[1], (N), (K)) |                    \
+                run_starts(stones, starts[2], (N) + 1, (K)) |                \
+                run_starts(stones, starts[3], (N) - 1, (K))) != 0;           \
+    }
+
+DEFINE_WIN_KERNEL(3, 3)
+DEFINE_WIN_KERNEL(4, 3)
+DEFINE_WIN_KERNEL(4, 4)
+DEFINE_WIN_KERNEL(5, 3)
+DEFINE_WIN_KERNEL(5, 4)
+DEFINE_WIN_KERNEL(5, 5)
+
+static const BitboardWinKernel g_kernels[BITBOARD_SIZE_COUNT][BITBOARD_SIZE_COUNT] = {
+    {has_win_3_3, NULL, NULL},
+    {has_win_4_3, has_win_4_4, NULL},
+    {has_win_5_3, has_win_5_4, has_win_5_5}
+};
+
+static void build_win_table(uint8_t n, uint8_t k) {
+    static const int8_t dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    WinTable* t = &g_tables[n - BITBOARD_MIN_SIZE][k - BITBOARD_MIN_SIZE];
+    int count = 0;
+
+    for (int d = 0; d < 4; d++) {
+        const int dr = dirs[d][0];
+        const int dc = dirs[d][1];
+
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                const int er = r + dr * (k - 1);
+                const int ec = c + dc * (k - 1);
+                if (er < 0 || er >= n || ec < 0 || ec >= n) continue;
+
+                Bitboard mask = 0;
+                for (int i = 0; i < k; i++) {
+                    mask |= BITBOARD_CELL(n, r + dr * i, c + dc * i);
+                }
+
+                t->masks[count].mask = mask;
+                t->masks[count].first = (uint8_t)(r * n + c);
+                t->masks[count].last = (uint8_t)(er * n + ec);
+                count++;
+            }
+        }
+    }
+
+    t->count = count;
+
+    for (int cell = 0; cell < n * n; cell++) {
+        uint8_t listed = 0;
+        for (int i = 0; i < count; i++) {
+            if (t->masks[i].mask & ((Bitboard)1u << cell)) {
+                t->cell_masks[cell][listed++] = (uint8_t)i;
+            }
+        }
+        t->cell_mask_count[cell] = listed;
+    }
+}
+
+void bitboard_init(void) {
+    if (g_tables_ready) return;
+
+    for (uint8_t n = BITBOARD_MIN_SIZE; n <= BITBOARD_MAX_SIZE; n++) {
+        for (uint8_t k = BITBOARD_MIN_SIZE; k <= n; k++) {
+            build_win_table(n, k);
+        }
+    }
+    g_tables_ready = true;
+}
+
+bool bitboard_supports(uint8_t size, uint8_t win_length) {
+    return size >= BITBOARD_MIN_SIZE && size <= BITBOARD_MAX_SIZE &&
+           win_length >= BITBOARD_MIN_SIZE && win_length <= size;
+}
+
+BitboardWinKernel bitboard_win_kernel(uint8_t size, uint8_t win_length) {
+    if (!bitboard_supports(size, win_length)) return NULL;
+    return g_kernels[size - BITBOARD_MIN_SIZE][win_length - BITBOARD_MIN_SIZE];
+}
+
+/* Start masks for runs to the right, down, down-right and down-left, which
+ * advance by 1, size, size + 1 and size - 1 bits per step. */
+const Bitboard* bitboard_run_starts(uint8_t size, uint8_t win_length) {
+    if (!bitboard_supports(size, win_length)) return NULL;
+    return g_run_starts[size - BITBOARD_MIN_SIZE][win_length - BITBOARD_MIN_SIZE];
+}
+
+Bitboard bitboard_full_mask(uint8_t size) {
+    const int cells = size * size;
+    return (cells >= 32) ? 0xFFFFFFFFu : (((Bitboard)1u << cells) - 1u);
+}
+
+static const WinTable* win_table(uint8_t size, uint8_t win_length) {
+    if (!bitboard_supports(size, win_length)) return NULL;
+    bitboard_init();
+    return &g_tables[size - BITBOARD_MIN_SIZE][win_length - BITBOARD_MIN_SIZE];
+}
+
+const WinMask* bitboard_win_masks(uint8_t size, uint8_t win_length, int* count) {
+    const WinTable* t = win_table(size, win_length);
+    if (count) *count = t ? t->count : 0;
+    return t ? t->masks : NULL;
+}
+
+const uint8_t* bitboard_cell_masks(uint8_t size, uint8_t win_length, uint8_t cell, int* count) {
+    const WinTable* t = win_table(size, win_length);
+    if (!t || cell >= size * size) {
+        if (count) *count = 0;
+        return NULL;
+    }
+    if (count) *count = t->cell_mask_count[cell];
+    return t->cell_masks[cell];
+}
@@ -0,0 +1,53 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BITBOARD_MAX_SIZE 5
+#define BITBOARD_MAX_WIN_MASKS 48
+#define BITBOARD_MAX_CELL_MASKS 12
+
+/* One bit per cell, bit index = row * size + col. */
+typedef uint32_t Bitboard;
+
+#define BITBOARD_CELL(size, row, col) ((Bitboard)1u << ((row) * (size) + (col)))
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+static inline int bitboard_lsb(Bitboard b) {
+    unsigned long index;
+    _BitScanForward(&index, b);
+    return (int)index;
+}
+static inline int bitboard_popcount(Bitboard b) {
+    return (int)__popcnt(b);
+}
+#else
+static inline int bitboard_lsb(Bitboard b) {
+    return __builtin_ctz(b);
+}
+static inline int bitboard_popcount(Bitboard b) {
+    return __builtin_popcount(b);
+}
+#endif
+
+typedef struct {
+    Bitboard mask;
+    uint8_t first;
+    uint8_t last;
+} WinMask;
+
+/* True when `stones` hold a complete line; specialized per (size, win_length). */
+typedef bool (*BitboardWinKernel)(Bitboard stones);
+
+void bitboard_init(void);
+bool bitboard_supports(uint8_t size, uint8_t win_length);
+BitboardWinKernel bitboard_win_kernel(uint8_t size, uint8_t win_length);
+const Bitboard* bitboard_run_starts(uint8_t size, uint8_t win_length);
+Bitboard bitboard_full_mask(uint8_t size);
+const WinMask* bitboard_win_masks(uint8_t size, uint8_t win_length, int* count);
+/* Indices into bitboard_win_masks() of the lines through `cell`. */
+const uint8_t* bitboard_cell_masks(uint8_t size, uint8_t win_length, uint8_t cell, int* count);
+
+#endif
@@ -0,0 +1,157 @@
+#include "book.h"
+#include "symmetry.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BOOK_MAGIC "TTTCXBK1"
+#define BOOK_VERSION 1
+#define BOOK_ENDIAN_CHECK 0x01020304u
+#define BOOK_MAX_ENTRIES (1u << 22)
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+    uint32_t count;
+    uint32_t reserved;
+} BookHeader;
+
+static BookEntry* g_entries = NULL;
+static size_t g_count = 0;
+
+static int compare_entries(const void* a, const void* b) {
+    const BookEntry* x = (const BookEntry*)a;
+    const BookEntry* y = (const BookEntry*)b;
+    if (x->key != y->key) return (x->key < y->key) ? -1 : 1;
+    if (x->weight != y->weight) return (x->weight > y->weight) ? -1 : 1;
+    return (int)x->cell - (int)y->cell;
+}
+
+bool book_write(const char* path, BookEntry* entries, size_t count) {
+    if (!path || (!entries && count > 0) || count > BOOK_MAX_ENTRIES) return false;
+
+    qsort(entries, count, sizeof(BookEntry), compare_entries);
+
+    BookHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BOOK_MAGIC, sizeof(header.magic));
+    header.version = BOOK_VERSION;
+    header.endian = BOOK_ENDIAN_CHECK;
+    header.count = (uint32_t)count;
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    if (ok && count > 0) {
+        ok = fwrite(entries, sizeof(BookEntry), count, f) == count;
+    }
+    if (fclose(f) != 0) ok = false;
+    return ok;
+}
+
+bool book_load(const char* path) {
+    if (!path) return false;
+    book_unload();
+
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+
+    BookHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 ||
+        memcmp(header.magic, BOOK_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != BOOK_VERSION || header.endian != BOOK_ENDIAN_CHECK ||
+        header.count == 0 || header.count > BOOK_MAX_ENTRIES) {
+        fclose(f);
+        return false;
+    }
+
+    BookEntry* entries = (BookEntry*)malloc(header.count * sizeof(BookEntry));
+    bool ok = entries && fread(entries, sizeof(BookEntry), header.count, f) == header.count;
+    fclose(f);
+
+    /* Lookups binary-search the array, so refuse anything out of order. */
+    for (uint32_t i = 1; ok && i < header.count; i++) {
+        ok = entries[i - 1].key <= entries[i].key;
+    }
+    if (!ok) {
+        free(entries);
+        return false;
+    }
+
+    g_entries = entries;
+    g_count = header.count;
+    return true;
+}
+
+void book_unload(void) {
+    free(g_entries);
+    g_entries = NULL;
+    g_count = 0;
+}
+
+bool book_is_loaded(void) {
+    return g_entries != NULL;
+}
+
+size_t book_lookup(uint64_t key, const BookEntry** first) {
+    if (first) *first = NULL;
+    if (!g_entries) return 0;
+
+    size_t lo = 0;
+    size_t hi = g_count;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (g_entries[mid].key < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    size_t end = lo;
+    while (end < g_count && g_entries[end].key == key) {
+        end++;
+    }
+    if (first && end > lo) *first = &g_entries[lo];
+    return end - lo;
+}
+
+bool book_best_move(const Game* game, Move* move, Rng* rng) {
+    if (!game || !move || !g_entries) return false;
+    if (game->state != GAME_STATE_PLAYING && game->state != GAME_STATE_WAITING) return false;
+
+    uint8_t transform = SYMMETRY_IDENTITY;
+    const uint64_t key = game_canonical_key(game, &transform);
+    const BookEntry* entries = NULL;
+    const size_t count = book_lookup(key, &entries);
+    if (count == 0) return false;
+
+    const uint8_t n = game->size;
+    const Symmetry back = symmetry_inverse((Symmetry)transform);
+    uint32_t total = 0;
+    uint16_t cells[MAX_MOVES];
+    uint16_t weights[MAX_MOVES];
+    int usable = 0;
+
+    for (size_t i = 0; i < count && usable < MAX_MOVES; i++) {
+        if (entries[i].cell >= n * n || entries[i].weight == 0) continue;
+        const uint16_t cell = symmetry_apply(n, back, entries[i].cell);
+        if (game->board[cell / n][cell % n] != PLAYER_NONE) continue;
+        cells[usable] = cell;
+        weights[usable++] = entries[i].weight;
+        total += entries[i].weight;
+    }
+    if (usable == 0) return false;
+
+    uint32_t pick = rng ? rng_below(rng, total) : 0;
+    int chosen = 0;
+    while (pick >= weights[chosen]) {
+        pick -= weights[chosen++];
+    }
+
+    move->row = (uint8_t)(cells[chosen] / n);
+    move->col = (uint8_t)(cells[chosen] % n);
+    return true;
+}
@@ -0,0 +1,32 @@
+#ifndef BOOK_H
+#define BOOK_H
+
+#include "game.h"
+#include "rng.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Opening book: canonical position key (game_canonical_key) to one or more
+ * moves with weights. Moves are stored in the canonical orientation and
+ * mapped back onto the real board at lookup. Entries are kept sorted by
+ * key so a lookup is a binary search over the loaded array.
+ */
+#define BOOK_DEFAULT_FILE "opening_book.bin"
+
+typedef struct {
+    uint64_t key;
+    uint16_t cell;
+    uint16_t weight;
+} BookEntry;
+
+bool book_write(const char* path, BookEntry* entries, size_t count);
+bool book_load(const char* path);
+void book_unload(void);
+bool book_is_loaded(void);
+size_t book_lookup(uint64_t key, const BookEntry** first);
+/* Picks among the stored moves by weight using `rng`; NULL takes the heaviest. */
+bool book_best_move(const Game* game, Move* move, Rng* rng);
+
+#endif
@@ -623,12 +623,14 @@ void cli_print_game_menu(int selected_index) {
         "Easy AI",
         "Medium AI",
         "Hard AI",
+        "Expert AI",
         "Back"
     };
     static const char* subtitles[] = {
         "Random moves",
         "Defensive and opportunistic",
-        "Minimax (hardest)",
+        "Minimax search",
+        "Monte Carlo tree search (large boards)",
         "Return to main menu"
     };
     const int option_count = (int)(sizeof(options) / sizeof(options[0]));
@@ -688,10 +690,11 @@ void cli_print_board(Game* game) {
     cli_clear_screen();
     print_theme_colors();
     printf(COLOR_TITLE "\n  %s " ANSI_YELLOW "v%s\n" ANSI_RESET, APP_NAME, APP_VERSION);
-    printf(ANSI_GRAY "  Live Match View\n\n" ANSI_RESET);
+    printf(ANSI_GRAY "  Live Match View | %d in a row wins\n\n" ANSI_RESET, game->win_length);
 
     const uint8_t n = game->size;
-    const uint8_t cell_width = 7;
+    const uint8_t cell_width = (n <= 5) ? 7 : 3;
+    const int pad = (cell_width - 1) / 2;
     const int row_digits = count_digits(n);
     const int left_padding = row_digits + 2;
 
@@ -704,15 +707,15 @@ void cli_print_board(Game* game) {
 
             printf("%s", g_glyphs->v);
             if (cell_is_on_win_line(game, i, j) && c != ' ') {
-                printf(COLOR_WIN "   %c   " ANSI_RESET, c);
+                printf(COLOR_WIN "%*s%c%*s" ANSI_RESET, pad, "", c, pad, "");
             } else if (c == game->symbol_x) {
-                printf(COLOR_X "   %c   " ANSI_RESET, c);
+                printf(COLOR_X "%*s%c%*s" ANSI_RESET, pad, "", c, pad, "");
             } else if (c == game->symbol_o) {
-                printf(COLOR_O "   %c   " ANSI_RESET, c);
+                printf(COLOR_O "%*s%c%*s" ANSI_RESET, pad, "", c, pad, "");
             } else if (cell_is_on_win_line(game, i, j)) {
-                printf(COLOR_WIN "   %s   " ANSI_RESET, g_glyphs->dot);
+                printf(COLOR_WIN "%*s%s%*s" ANSI_RESET, pad, "", g_glyphs->dot, pad, "");
             } else {
-                printf("       ");
+                printf("%*s", (int)cell_width, "");
             }
         }
         printf("%s\n", g_glyphs->v);
@@ -819,6 +822,120 @@ void cli_print_ai_thinking(void) {
     printf("\r                    \r");
 }
 
+void cli_print_ai_stats(const AiStats* stats) {
+    if (!stats) return;
+
+    printf("  " ANSI_GRAY "[%s%s] %llu nodes in %llums (%llu/s), depth %d, max ply %d, score %d\n",
+           ai_source_name(stats->source), stats->ponder_hit ? ", ponder hit" : "",
+           (unsigned long long)stats->nodes, (unsigned long long)stats->elapsed_ms,
+           (unsigned long long)stats->nodes_per_sec, stats->depth, stats->max_ply, stats->score);
+
+    if (stats->tt_probes > 0) {
+        printf("  tt %llu/%llu hits (%.1f%%), cutoffs by move:",
+               (unsigned long long)stats->tt_hits, (unsigned long long)stats->tt_probes,
+               100.0 * (double)stats->tt_hits / (double)stats->tt_probes);
+        for (int i = 0; i < AI_STATS_CUTOFF_SLOTS; i++) {
+            printf(" %llu", (unsigned long long)stats->cutoffs[i]);
+        }
+        printf("\n");
+    }
+
+    if (stats->iterations > 0) {
+        printf("  iterations (ms):");
+        for (int i = 0; i < stats->iterations; i++) {
+            printf(" %u", stats->iteration_ms[i]);
+        }
+        printf("\n");
+    }
+
+    printf("  pv:");
+    for (int i = 0; i < stats->pv_length; i++) {
+        printf(" %u,%u", stats->pv[i].row + 1, stats->pv[i].col + 1);
+    }
+    printf(ANSI_RESET "\n");
+}
+
+#define CLI_HINT_TOP_MOVES 3
+
+/* "wins in 2", "draw", "loses in 1", or the raw score. */
+static void describe_move(const AiMoveAnalysis* m, char* out, size_t size) {
+    switch (m->verdict) {
+        case AI_VERDICT_WIN: (void)snprintf(out, size, "wins in %d", (m->plies + 1) / 2); break;
+        case AI_VERDICT_LOSS: (void)snprintf(out, size, "loses in %d", (m->plies > 1) ? m->plies / 2 : 1); break;
+        case AI_VERDICT_DRAW: (void)snprintf(out, size, "draw"); break;
+        default: (void)snprintf(out, size, "%+d", m->score); break;
+    }
+}
+
+void cli_print_move_heatmap(const Game* game, const AiMoveAnalysis* moves, int count) {
+    if (!game || !moves || count <= 0) return;
+
+    const uint8_t n = game->size;
+    const int row_digits = count_digits(n);
+    int heat[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
+    int low = 0;
+    int high = 0;
+    bool ranged = false;
+
+    /* Unproven moves get 0-9 across the range of unproven scores. */
+    for (int i = 0; i < count; i++) {
+        if (moves[i].verdict != AI_VERDICT_UNKNOWN) continue;
+        if (!ranged || moves[i].score < low) low = moves[i].score;
+        if (!ranged || moves[i].score > high) high = moves[i].score;
+        ranged = true;
+    }
+    memset(heat, -1, sizeof(heat));
+    for (int i = 0; i < count; i++) {
+        heat[moves[i].move.row][moves[i].move.col] = i;
+    }
+
+    const char mover = (game->current_player == PLAYER_X) ? game->symbol_x : game->symbol_o;
+    printf("\n  " COLOR_TITLE "Move hints for %c" ANSI_RESET ANSI_GRAY " (W win, = draw, L loss, 9-0 best to worst)" ANSI_RESET "\n",
+           mover);
+
+    printf("  %*s", row_digits + 1, "");
+    for (uint8_t c = 0; c < n; c++) {
+        printf(ANSI_GRAY "%3u" ANSI_RESET, (unsigned int)(c + 1));
+    }
+    printf("\n");
+
+    for (uint8_t r = 0; r < n; r++) {
+        printf("  " ANSI_GRAY "%*u " ANSI_RESET, row_digits, (unsigned int)(r + 1));
+        for (uint8_t c = 0; c < n; c++) {
+            const int index = heat[r][c];
+            if (index < 0) {
+                const char stone = game_get_cell_char(game, r, c);
+                printf(ANSI_GRAY "  %c" ANSI_RESET, stone == ' ' ? '.' : stone);
+                continue;
+            }
+
+            const AiMoveAnalysis* m = &moves[index];
+            const char* best = (m->score == moves[0].score) ? ANSI_BOLD ANSI_UNDERLINE : "";
+            if (m->verdict == AI_VERDICT_WIN) {
+                printf("  %s" ANSI_BRIGHT_GREEN "W" ANSI_RESET, best);
+            } else if (m->verdict == AI_VERDICT_LOSS) {
+                printf("  %s" ANSI_RED "L" ANSI_RESET, best);
+            } else if (m->verdict == AI_VERDICT_DRAW) {
+                printf("  %s" ANSI_YELLOW "=" ANSI_RESET, best);
+            } else {
+                const int level = (high > low) ? (m->score - low) * 9 / (high - low) : 9;
+                const char* color = (level >= 7) ? ANSI_BRIGHT_GREEN : (level >= 4) ? ANSI_BRIGHT_YELLOW : ANSI_GRAY;
+                printf("  %s%s%d" ANSI_RESET, best, color, level);
+            }
+        }
+        printf("\n");
+    }
+
+    printf("  " ANSI_CYAN "Best:" ANSI_RESET);
+    for (int i = 0; i < count && i < CLI_HINT_TOP_MOVES; i++) {
+        char label[32];
+        describe_move(&moves[i], label, sizeof(label));
+        printf("%s %u,%u (%s)", i ? " |" : "", moves[i].move.row + 1, moves[i].move.col + 1, label);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
 void cli_print_highscores(const Score* score) {
     print_theme_colors();
     
@@ -872,7 +989,7 @@ void cli_print_settings_menu(const Config* cfg, int selected_index) {
     (void)snprintf(option_sound, sizeof(option_sound), "Sound: %s", sound_enabled ? "On" : "Off");
 
     static const char* subtitles[] = {
-        "3x3, 4x4, or 5x5",
+        "3x3 up to 19x19",
         "Default, Dark, Light, Retro",
         "Seconds per move (0 = off)",
         "Choose X or O",
@@ -947,6 +1064,7 @@ void cli_print_game_controls(void) {
     printf(ANSI_WHITE "  Enter move: " ANSI_CYAN "23" ANSI_WHITE " or " ANSI_CYAN "2 3" ANSI_WHITE "\n\n");
     printf(ANSI_WHITE "  " ANSI_CYAN "[U]" ANSI_WHITE "  Undo last move\n");
     printf(ANSI_WHITE "  " ANSI_CYAN "[R]" ANSI_WHITE "  Redo move\n");
+    printf(ANSI_WHITE "  " ANSI_CYAN "[H]" ANSI_WHITE "  Move hints (heatmap)\n");
     printf(ANSI_WHITE "  " ANSI_CYAN "[Q]" ANSI_WHITE "  Quit to menu\n");
     printf(ANSI_WHITE "  " ANSI_CYAN "[S]" ANSI_WHITE "  Save replay\n\n");
     
@@ -2,6 +2,7 @@
 #define CLI_H
 
 #include <stdio.h>
+#include "ai.h"
 #include "game.h"
 #include "utils.h"
 
@@ -73,6 +74,8 @@ void cli_print_board(Game* game);
 void cli_print_move_prompt(void);
 void cli_print_game_over(Game* game);
 void cli_print_ai_thinking(void);
+void cli_print_ai_stats(const AiStats* stats);
+void cli_print_move_heatmap(const Game* game, const AiMoveAnalysis* moves, int count);
 void cli_set_theme(ColorTheme theme);
 void cli_print_highscores(const Score* score);
 void cli_print_settings_menu(const Config* cfg, int selected_index);
@@ -0,0 +1,332 @@
+#include "dfpn.h"
+#include "monotime.h"
+#include "position.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define DFPN_INF 0x3FFFFFFFu
+#define DFPN_CLOCK_MASK 1023u
+#define DFPN_MAX_CELLS (BITBOARD_MAX_SIZE * BITBOARD_MAX_SIZE)
+#define DFPN_NO_CELL (-1)
+
+/* Keeps the two attackers' numbers for one position apart in the table. */
+#define DFPN_ATTACKER_O_KEY 0x6A09E667F3BCC909ULL
+
+typedef struct {
+    uint64_t key;
+    uint32_t pn;
+    uint32_t dn;
+} DfpnEntry;
+
+typedef struct {
+    BitboardWinKernel has_win;
+    const WinMask* lines;
+    int line_count;
+    Player attacker;
+    uint64_t key_xor;
+    uint64_t nodes;
+    uint64_t node_limit;
+    uint64_t deadline_ms;
+    const volatile int* cancel;
+    bool stopped;
+    int root_cell;
+} Solver;
+
+static DfpnEntry* g_entries = NULL;
+static size_t g_mask = 0;
+static size_t g_megabytes = DFPN_DEFAULT_TABLE_MB;
+
+static bool table_ready(void) {
+    if (g_entries) return true;
+    if (g_megabytes == 0) return false;
+
+    const size_t budget = g_megabytes * 1024u * 1024u;
+    size_t count = 2;
+    while (count * 2 * sizeof(DfpnEntry) <= budget) {
+        count *= 2;
+    }
+    g_entries = (DfpnEntry*)calloc(count, sizeof(DfpnEntry));
+    if (!g_entries) return false;
+    g_mask = count - 1;
+    return true;
+}
+
+void dfpn_set_table_size(size_t megabytes) {
+    if (megabytes == g_megabytes) return;
+    free(g_entries);
+    g_entries = NULL;
+    g_mask = 0;
+    g_megabytes = megabytes;
+}
+
+void dfpn_clear(void) {
+    if (g_entries) memset(g_entries, 0, (g_mask + 1) * sizeof(DfpnEntry));
+}
+
+static bool is_solved(const DfpnEntry* entry) {
+    return entry->pn == 0 || entry->dn == 0;
+}
+
+static bool table_lookup(uint64_t key, uint32_t* pn, uint32_t* dn) {
+    const size_t index = key & g_mask;
+    for (size_t i = 0; i < 2; i++) {
+        const DfpnEntry* entry = &g_entries[index ^ i];
+        if (entry->key == key && (entry->pn | entry->dn) != 0) {
+            *pn = entry->pn;
+            *dn = entry->dn;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Two-way buckets; solved entries outlive open ones. */
+static void table_store(uint64_t key, uint32_t pn, uint32_t dn) {
+    DfpnEntry* a = &g_entries[key & g_mask];
+    DfpnEntry* b = &g_entries[(key & g_mask) ^ 1];
+    DfpnEntry* slot = a;
+    if (b->key == key) {
+        slot = b;
+    } else if (a->key != key && is_solved(a) && !is_solved(b)) {
+        slot = b;
+    }
+    slot->key = key;
+    slot->pn = pn;
+    slot->dn = dn;
+}
+
+static uint32_t saturating_add(uint32_t a, uint32_t b) {
+    const uint32_t sum = a + b;
+    return (sum >= DFPN_INF) ? DFPN_INF : sum;
+}
+
+static Bitboard threat_cells(const Solver* s, Bitboard stones, Bitboard empty) {
+    Bitboard threats = 0;
+    for (int i = 0; i < s->line_count; i++) {
+        const Bitboard rest = s->lines[i].mask & ~stones;
+        if ((rest & (rest - 1)) == 0) {
+            threats |= rest;
+        }
+    }
+    return threats & empty;
+}
+
+/* Numbers for `winner` having won: proved when it is the attacker. */
+static void set_won(const Solver* s, Player winner, uint32_t* pn, uint32_t* dn) {
+    *pn = (winner == s->attacker) ? 0 : DFPN_INF;
+    *dn = (winner == s->attacker) ? DFPN_INF : 0;
+}
+
+/* Numbers for the position just reached, without expanding it. */
+static void child_numbers(const Solver* s, const Position* pos, uint32_t* pn, uint32_t* dn) {
+    const Player mover = (position_side(pos) == PLAYER_X) ? PLAYER_O : PLAYER_X;
+    if (position_mover_wins(pos, s->has_win)) {
+        set_won(s, mover, pn, dn);
+        return;
+    }
+    if (position_empty_count(pos) == 0) {
+        *pn = DFPN_INF;
+        *dn = 0;
+        return;
+    }
+    if (!table_lookup(pos->hash ^ s->key_xor, pn, dn)) {
+        *pn = 1;
+        *dn = 1;
+    }
+}
+
+/* Lists the moves worth trying, or returns false with the node's numbers
+ * when the threats already decide it (listing the winning cell, if any). */
+static bool expand(const Solver* s, const Position* pos, uint8_t* cells, int* count, uint32_t* pn, uint32_t* dn) {
+    const Player side = position_side(pos);
+    const Player other = (side == PLAYER_X) ? PLAYER_O : PLAYER_X;
+    const Bitboard empty = position_empty(pos);
+
+    const Bitboard wins = threat_cells(s, position_stones(pos, side), empty);
+    *count = 0;
+    if (wins) {
+        cells[(*count)++] = (uint8_t)bitboard_lsb(wins);
+        set_won(s, side, pn, dn);
+        return false;
+    }
+
+    Bitboard moves = threat_cells(s, position_stones(pos, other), empty);
+    if (bitboard_popcount(moves) >= 2) {
+        set_won(s, other, pn, dn);
+        return false;
+    }
+    if (!moves) moves = empty;
+
+    for (; moves; moves &= moves - 1) {
+        cells[(*count)++] = (uint8_t)bitboard_lsb(moves);
+    }
+    return true;
+}
+
+static void count_node(Solver* s) {
+    s->nodes++;
+    if (s->node_limit && s->nodes >= s->node_limit) {
+        s->stopped = true;
+    } else if ((s->nodes & DFPN_CLOCK_MASK) == 0 &&
+               ((s->cancel && *s->cancel) || (s->deadline_ms && monotime_ms() >= s->deadline_ms))) {
+        s->stopped = true;
+    }
+}
+
+/* Multiple-iterative deepening: works below this node until its proof or
+ * disproof number reaches the threshold it was given. */
+static void mid(Solver* s, Position* pos, int ply, uint32_t th_pn, uint32_t th_dn, uint32_t* out_pn, uint32_t* out_dn) {
+    count_node(s);
+
+    uint8_t cells[DFPN_MAX_CELLS];
+    uint32_t child_pn[DFPN_MAX_CELLS];
+    uint32_t child_dn[DFPN_MAX_CELLS];
+    int count = 0;
+    uint32_t pn = 1;
+    uint32_t dn = 1;
+
+    if (!expand(s, pos, cells, &count, &pn, &dn)) {
+        if (ply == 0) s->root_cell = count ? cells[0] : DFPN_NO_CELL;
+        table_store(pos->hash ^ s->key_xor, pn, dn);
+        *out_pn = pn;
+        *out_dn = dn;
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        position_make(pos, cells[i]);
+        child_numbers(s, pos, &child_pn[i], &child_dn[i]);
+        position_unmake(pos, cells[i]);
+    }
+
+    const bool or_node = position_side(pos) == s->attacker;
+    int best = 0;
+
+    for (;;) {
+        /* At an OR node the attacker picks the easiest proof; at an AND
+         * node the defender picks the easiest disproof. */
+        uint32_t second = DFPN_INF;
+        best = 0;
+        pn = or_node ? DFPN_INF : 0;
+        dn = or_node ? 0 : DFPN_INF;
+        for (int i = 0; i < count; i++) {
+            const uint32_t key = or_node ? child_pn[i] : child_dn[i];
+            const uint32_t best_key = or_node ? child_pn[best] : child_dn[best];
+            if (i > 0 && key < best_key) {
+                second = best_key;
+                best = i;
+            } else if (i > 0 && key < second) {
+                second = key;
+            }
+            if (or_node) {
+                if (child_pn[i] < pn) pn = child_pn[i];
+                dn = saturating_add(dn, child_dn[i]);
+            } else {
+                pn = saturating_add(pn, child_pn[i]);
+                if (child_dn[i] < dn) dn = child_dn[i];
+            }
+        }
+
+        if (pn >= th_pn || dn >= th_dn || s->stopped) break;
+
+        uint32_t next_pn;
+        uint32_t next_dn;
+        if (or_node) {
+            next_pn = (th_pn < second + 1) ? th_pn : second + 1;
+            next_dn = th_dn - dn + child_dn[best];
+        } else {
+            next_dn = (th_dn < second + 1) ? th_dn : second + 1;
+            next_pn = th_pn - pn + child_pn[best];
+        }
+        if (next_pn > DFPN_INF) next_pn = DFPN_INF;
+        if (next_dn > DFPN_INF) next_dn = DFPN_INF;
+
+        position_make(pos, cells[best]);
+        mid(s, pos, ply + 1, next_pn, next_dn, &child_pn[best], &child_dn[best]);
+        position_unmake(pos, cells[best]);
+    }
+
+    if (ply == 0) {
+        s->root_cell = DFPN_NO_CELL;
+        for (int i = 0; i < count; i++) {
+            if ((or_node ? child_pn[i] : child_dn[i]) == 0) {
+                s->root_cell = cells[i];
+                break;
+            }
+        }
+    }
+    if (!s->stopped) table_store(pos->hash ^ s->key_xor, pn, dn);
+    *out_pn = pn;
+    *out_dn = dn;
+}
+
+/* True when `attacker` is proved to win (false with *open set if unknown). */
+static bool prove(Solver* s, Position* pos, Player attacker, bool* open) {
+    uint32_t pn = 0;
+    uint32_t dn = 0;
+    s->attacker = attacker;
+    s->key_xor = (attacker == PLAYER_O) ? DFPN_ATTACKER_O_KEY : 0;
+    s->root_cell = DFPN_NO_CELL;
+    mid(s, pos, 0, DFPN_INF, DFPN_INF, &pn, &dn);
+    *open = pn != 0 && dn != 0;
+    return pn == 0;
+}
+
+bool dfpn_supports(const Game* game) {
+    return game && bitboard_supports(game->size, game->win_length);
+}
+
+DfpnResult dfpn_solve(const Game* game, const DfpnBudget* budget, Move* move, uint64_t* nodes) {
+    if (nodes) *nodes = 0;
+    if (move && game) {
+        move->row = game->size;
+        move->col = game->size;
+    }
+    if (!dfpn_supports(game) || game->state != GAME_STATE_PLAYING || !table_ready()) return DFPN_UNKNOWN;
+
+    Position pos;
+    if (!position_from_game(&pos, game) || position_empty_count(&pos) == 0) return DFPN_UNKNOWN;
+
+    Solver s;
+    memset(&s, 0, sizeof(s));
+    s.has_win = bitboard_win_kernel(game->size, game->win_length);
+    s.lines = bitboard_win_masks(game->size, game->win_length, &s.line_count);
+    if (budget) {
+        s.node_limit = budget->node_limit;
+        s.deadline_ms = budget->deadline_ms;
+        s.cancel = budget->cancel;
+    }
+
+    const Player side = position_side(&pos);
+    const Player other = (side == PLAYER_X) ? PLAYER_O : PLAYER_X;
+    DfpnResult result = DFPN_UNKNOWN;
+    bool open = false;
+
+    if (prove(&s, &pos, side, &open)) {
+        result = DFPN_WIN;
+    } else if (!open) {
+        if (prove(&s, &pos, other, &open)) {
+            result = DFPN_LOSS;
+        } else if (!open) {
+            result = DFPN_DRAW;
+        }
+    }
+
+    /* The root cell is only meaningful for a proof at an OR root (a win)
+     * or a disproof at an AND root (a move that holds the draw). */
+    if (move && (result == DFPN_WIN || result == DFPN_DRAW) && s.root_cell != DFPN_NO_CELL) {
+        move->row = (uint8_t)(s.root_cell / game->size);
+        move->col = (uint8_t)(s.root_cell % game->size);
+    }
+    if (nodes) *nodes = s.nodes;
+    return result;
+}
+
+const char* dfpn_result_name(DfpnResult result) {
+    switch (result) {
+        case DFPN_WIN: return "win";
+        case DFPN_LOSS: return "loss";
+        case DFPN_DRAW: return "draw";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef DFPN_H
+#define DFPN_H
+
+#include "game.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Depth-first proof-number search for the bitboard boards (up to 5x5).
+ * It proves whether the side to move can force a win, and if not whether
+ * the opponent can, without a depth limit. Forced blocks and double
+ * threats are resolved at expansion, so tactical lines collapse quickly.
+ * Proof and disproof numbers live in a fixed-size table that is kept
+ * between calls; one solve runs at a time.
+ */
+#define DFPN_DEFAULT_TABLE_MB 8
+
+typedef enum {
+    DFPN_UNKNOWN,   /* budget ran out */
+    DFPN_WIN,       /* the side to move forces a win */
+    DFPN_LOSS,      /* every move loses */
+    DFPN_DRAW       /* neither side can force a win */
+} DfpnResult;
+
+typedef struct {
+    uint64_t deadline_ms;   /* absolute on monotime_ms(), 0 for none */
+    uint64_t node_limit;    /* 0 for none */
+    const volatile int* cancel;
+} DfpnBudget;
+
+bool dfpn_supports(const Game* game);
+/* `move` gets the winning move for DFPN_WIN and a holding move for
+ * DFPN_DRAW; otherwise it is left off the board. */
+DfpnResult dfpn_solve(const Game* game, const DfpnBudget* budget, Move* move, uint64_t* nodes);
+/* 0 disables the solver. The table is allocated on the next solve. */
+void dfpn_set_table_size(size_t megabytes);
+void dfpn_clear(void);
+const char* dfpn_result_name(DfpnResult result);
+
+#endif
@@ -0,0 +1,420 @@
+#include "enddb.h"
+#include "bitboard.h"
+#include "symmetry.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#define ENDDB_MAGIC "TTTCXDB4"
+#define ENDDB_VERSION 1
+#define ENDDB_ENDIAN_CHECK 0x01020304u
+#define ENDDB_BLOCK_WORDS 8
+/* Symmetry classes among the dense indices: the values enddb_write() stores. */
+#define ENDDB_CANONICAL_COUNT 1273771u
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+    uint32_t position_count;
+    uint32_t canonical_count;
+    uint32_t bitmap_words;
+    uint32_t directory_count;
+} EndDbHeader;
+
+static uint32_t g_binomial[ENDDB_CELLS + 1][ENDDB_CELLS + 1];
+static uint32_t g_layer_start[ENDDB_CELLS + 2];
+static uint16_t g_transform[SYMMETRY_COUNT][2][256];
+static uint16_t g_rank_low[256];
+static uint16_t g_rank_high[9][256];
+static bool g_tables_ready = false;
+
+static struct {
+    const uint8_t* base;
+    size_t length;
+    const uint64_t* bitmap;
+    const uint32_t* directory;
+    const uint8_t* values;
+    uint32_t bitmap_words;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} g_map;
+
+static int popcount16(uint32_t bits) {
+    return bitboard_popcount((Bitboard)bits);
+}
+
+static int popcount64(uint64_t bits) {
+    return bitboard_popcount((Bitboard)bits) + bitboard_popcount((Bitboard)(bits >> 32));
+}
+
+void enddb_init(void) {
+    if (g_tables_ready) return;
+
+    for (int n = 0; n <= ENDDB_CELLS; n++) {
+        g_binomial[n][0] = 1;
+        for (int k = 1; k <= n; k++) {
+            g_binomial[n][k] = g_binomial[n - 1][k - 1] + ((k <= n - 1) ? g_binomial[n - 1][k] : 0);
+        }
+    }
+
+    g_layer_start[0] = 0;
+    for (int m = 0; m <= ENDDB_CELLS; m++) {
+        const int xs = (m + 1) / 2;
+        const int os = m / 2;
+        g_layer_start[m + 1] = g_layer_start[m] + g_binomial[ENDDB_CELLS][xs] * g_binomial[ENDDB_CELLS - xs][os];
+    }
+
+    for (int t = 0; t < SYMMETRY_COUNT; t++) {
+        const uint16_t* map = symmetry_cell_map(ENDDB_SIZE, (Symmetry)t);
+        for (int half = 0; half < 2; half++) {
+            for (int byte = 0; byte < 256; byte++) {
+                uint16_t out = 0;
+                for (int bit = 0; bit < 8; bit++) {
+                    if (byte & (1 << bit)) out |= (uint16_t)(1u << map[half * 8 + bit]);
+                }
+                g_transform[t][half][byte] = out;
+            }
+        }
+    }
+
+    /* Colex rank: the i-th set bit (from 0) at position p adds C(p, i + 1). */
+    for (int byte = 0; byte < 256; byte++) {
+        uint32_t low = 0;
+        int ordinal = 0;
+        for (int bit = 0; bit < 8; bit++) {
+            if (byte & (1 << bit)) low += g_binomial[bit][++ordinal];
+        }
+        g_rank_low[byte] = (uint16_t)low;
+
+        for (int below = 0; below <= 8; below++) {
+            uint32_t high = 0;
+            ordinal = below;
+            for (int bit = 0; bit < 8; bit++) {
+                if (byte & (1 << bit)) high += g_binomial[8 + bit][++ordinal];
+            }
+            g_rank_high[below][byte] = (uint16_t)high;
+        }
+    }
+
+    g_tables_ready = true;
+}
+
+uint32_t enddb_position_count(void) {
+    enddb_init();
+    return g_layer_start[ENDDB_CELLS + 1];
+}
+
+uint32_t enddb_layer_start(int stones) {
+    enddb_init();
+    if (stones < 0) stones = 0;
+    if (stones > ENDDB_CELLS + 1) stones = ENDDB_CELLS + 1;
+    return g_layer_start[stones];
+}
+
+static uint32_t colex_rank16(uint16_t bits) {
+    return (uint32_t)g_rank_low[bits & 0xFF] + g_rank_high[popcount16(bits & 0xFF)][bits >> 8];
+}
+
+static uint16_t colex_unrank(uint32_t rank, int count, int width) {
+    uint16_t bits = 0;
+    for (int i = count; i >= 1; i--) {
+        int p = width - 1;
+        while (g_binomial[p][i] > rank) p--;
+        bits |= (uint16_t)(1u << p);
+        rank -= g_binomial[p][i];
+    }
+    return bits;
+}
+
+uint32_t enddb_index(uint16_t x, uint16_t o) {
+    enddb_init();
+
+    const int xs = popcount16(x);
+    const int os = popcount16(o);
+    if ((x & o) || (xs != os && xs != os + 1)) return ENDDB_INVALID_INDEX;
+
+    /* Rank O among the free cells: each O bit drops below it the X cells. */
+    uint32_t rank_o = 0;
+    int ordinal = 0;
+    uint16_t rest = o;
+    while (rest) {
+        const int p = bitboard_lsb(rest);
+        rest &= (uint16_t)(rest - 1);
+        const int squeezed = p - popcount16(x & ((1u << p) - 1u));
+        rank_o += g_binomial[squeezed][++ordinal];
+    }
+
+    return g_layer_start[xs + os] + colex_rank16(x) * g_binomial[ENDDB_CELLS - xs][os] + rank_o;
+}
+
+bool enddb_unrank(uint32_t index, uint16_t* x, uint16_t* o) {
+    enddb_init();
+    if (index >= enddb_position_count() || !x || !o) return false;
+
+    int m = 0;
+    while (g_layer_start[m + 1] <= index) m++;
+
+    const int xs = (m + 1) / 2;
+    const int os = m / 2;
+    const uint32_t width = g_binomial[ENDDB_CELLS - xs][os];
+    const uint32_t offset = index - g_layer_start[m];
+
+    *x = colex_unrank(offset / width, xs, ENDDB_CELLS);
+    const uint16_t squeezed = colex_unrank(offset % width, os, ENDDB_CELLS - xs);
+
+    *o = 0;
+    int free_cell = 0;
+    for (int cell = 0; cell < ENDDB_CELLS; cell++) {
+        if (*x & (1u << cell)) continue;
+        if (squeezed & (1u << free_cell)) *o |= (uint16_t)(1u << cell);
+        free_cell++;
+    }
+    return true;
+}
+
+/* The symmetric copy with the smallest (X, O) pair is canonical. */
+void enddb_canonical(uint16_t x, uint16_t o, uint16_t* cx, uint16_t* co) {
+    enddb_init();
+
+    uint32_t best = 0xFFFFFFFFu;
+    for (int t = 0; t < SYMMETRY_COUNT; t++) {
+        const uint16_t tx = g_transform[t][0][x & 0xFF] | g_transform[t][1][x >> 8];
+        const uint16_t to = g_transform[t][0][o & 0xFF] | g_transform[t][1][o >> 8];
+        const uint32_t key = ((uint32_t)tx << 16) | to;
+        if (key < best) best = key;
+    }
+    *cx = (uint16_t)(best >> 16);
+    *co = (uint16_t)(best & 0xFFFFu);
+}
+
+/* values holds one byte per dense index; non-zero bytes are written. */
+bool enddb_write(const char* path, const uint8_t* values) {
+    if (!path || !values) return false;
+
+    const uint32_t count = enddb_position_count();
+    EndDbHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ENDDB_MAGIC, sizeof(header.magic));
+    header.version = ENDDB_VERSION;
+    header.endian = ENDDB_ENDIAN_CHECK;
+    header.position_count = count;
+    header.bitmap_words = (count + 63) / 64;
+    header.directory_count = (header.bitmap_words + ENDDB_BLOCK_WORDS - 1) / ENDDB_BLOCK_WORDS;
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (values[i]) header.canonical_count++;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+
+    for (uint32_t w = 0; ok && w < header.bitmap_words; w++) {
+        uint64_t word = 0;
+        for (uint32_t b = 0; b < 64 && w * 64 + b < count; b++) {
+            if (values[w * 64 + b]) word |= (uint64_t)1u << b;
+        }
+        ok = fwrite(&word, sizeof(word), 1, f) == 1;
+    }
+
+    uint32_t ranked = 0;
+    for (uint32_t d = 0; ok && d < header.directory_count; d++) {
+        ok = fwrite(&ranked, sizeof(ranked), 1, f) == 1;
+        for (uint32_t i = d * ENDDB_BLOCK_WORDS * 64; i < (d + 1) * ENDDB_BLOCK_WORDS * 64 && i < count; i++) {
+            if (values[i]) ranked++;
+        }
+    }
+
+    for (uint32_t i = 0; ok && i < count; i++) {
+        if (values[i]) ok = fputc(values[i], f) != EOF;
+    }
+
+    if (fclose(f) != 0) ok = false;
+    return ok;
+}
+
+/* Every directory entry must match the bits before its block, and the bits
+ * must add up to the values stored, or a probe could read past the map. */
+static bool directory_matches(const uint64_t* bitmap, const uint32_t* directory, const EndDbHeader* header) {
+    uint32_t ranked = 0;
+    for (uint32_t w = 0; w < header->bitmap_words; w++) {
+        if (w % ENDDB_BLOCK_WORDS == 0 && directory[w / ENDDB_BLOCK_WORDS] != ranked) return false;
+        ranked += (uint32_t)popcount64(bitmap[w]);
+    }
+    return ranked == header->canonical_count;
+}
+
+bool enddb_open(const char* path) {
+    if (!path) return false;
+    enddb_close();
+    enddb_init();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(EndDbHeader)) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    const uint8_t* base = mapping ? (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!base) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    g_map.file = file;
+    g_map.mapping = mapping;
+    g_map.length = (size_t)size.QuadPart;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(EndDbHeader)) {
+        close(fd);
+        return false;
+    }
+    void* mapped = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    const uint8_t* base = (const uint8_t*)mapped;
+    g_map.length = (size_t)st.st_size;
+#endif
+    g_map.base = base;
+
+    EndDbHeader header;
+    memcpy(&header, base, sizeof(header));
+    const size_t expected = sizeof(header) +
+                            (size_t)header.bitmap_words * sizeof(uint64_t) +
+                            (size_t)header.directory_count * sizeof(uint32_t) +
+                            header.canonical_count;
+
+    if (memcmp(header.magic, ENDDB_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != ENDDB_VERSION || header.endian != ENDDB_ENDIAN_CHECK ||
+        header.position_count != enddb_position_count() ||
+        header.bitmap_words != (header.position_count + 63) / 64 ||
+        header.directory_count != (header.bitmap_words + ENDDB_BLOCK_WORDS - 1) / ENDDB_BLOCK_WORDS ||
+        header.canonical_count != ENDDB_CANONICAL_COUNT ||
+        g_map.length != expected) {
+        enddb_close();
+        return false;
+    }
+
+    g_map.bitmap = (const uint64_t*)(base + sizeof(header));
+    g_map.directory = (const uint32_t*)(g_map.bitmap + header.bitmap_words);
+    if (!directory_matches(g_map.bitmap, g_map.directory, &header)) {
+        enddb_close();
+        return false;
+    }
+    g_map.values = (const uint8_t*)(g_map.directory + header.directory_count);
+    g_map.bitmap_words = header.bitmap_words;
+    return true;
+}
+
+void enddb_close(void) {
+    if (!g_map.base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(g_map.base);
+    CloseHandle(g_map.mapping);
+    CloseHandle(g_map.file);
+#else
+    munmap((void*)g_map.base, g_map.length);
+#endif
+    memset(&g_map, 0, sizeof(g_map));
+}
+
+bool enddb_is_open(void) {
+    return g_map.base != NULL;
+}
+
+bool enddb_probe(uint16_t x, uint16_t o, EndDbEntry* entry) {
+    if (!g_map.base || !entry) return false;
+
+    uint16_t cx, co;
+    enddb_canonical(x, o, &cx, &co);
+    const uint32_t index = enddb_index(cx, co);
+    if (index == ENDDB_INVALID_INDEX) return false;
+
+    const uint32_t word = index / 64;
+    const uint64_t bit = (uint64_t)1u << (index % 64);
+    if (!(g_map.bitmap[word] & bit)) return false;
+
+    uint32_t slot = g_map.directory[word / ENDDB_BLOCK_WORDS];
+    for (uint32_t w = word - word % ENDDB_BLOCK_WORDS; w < word; w++) {
+        slot += (uint32_t)popcount64(g_map.bitmap[w]);
+    }
+    slot += (uint32_t)popcount64(g_map.bitmap[word] & (bit - 1));
+
+    entry->result = ENDDB_VALUE_RESULT(g_map.values[slot]);
+    entry->distance = ENDDB_VALUE_DISTANCE(g_map.values[slot]);
+    return entry->result != ENDDB_UNKNOWN;
+}
+
+bool enddb_best_move(const Game* game, Move* move, EndDbEntry* entry) {
+    if (!g_map.base || !game || !move) return false;
+    if (game->size != ENDDB_SIZE || game->win_length != ENDDB_SIZE) return false;
+
+    uint16_t stones[2] = {0, 0};
+    for (uint8_t r = 0; r < ENDDB_SIZE; r++) {
+        stones[0] |= (uint16_t)(game->lines.rows[0][r] << (r * ENDDB_SIZE));
+        stones[1] |= (uint16_t)(game->lines.rows[1][r] << (r * ENDDB_SIZE));
+    }
+
+    const int side = (popcount16(stones[0]) == popcount16(stones[1])) ? 0 : 1;
+    if (game->current_player != (Player)(side + 1)) return false;
+
+    EndDbEntry here;
+    if (!enddb_probe(stones[0], stones[1], &here)) return false;
+
+    const BitboardWinKernel has_win = bitboard_win_kernel(ENDDB_SIZE, ENDDB_SIZE);
+    const uint16_t empty = (uint16_t)~(stones[0] | stones[1]);
+    int best_score = -1000;
+    int best_cell = -1;
+
+    for (int cell = 0; cell < ENDDB_CELLS; cell++) {
+        if (!(empty & (1u << cell))) continue;
+
+        uint16_t next[2] = {stones[0], stones[1]};
+        next[side] |= (uint16_t)(1u << cell);
+
+        int score;
+        EndDbEntry reply;
+        if (has_win(next[side])) {
+            score = 1000;
+        } else if (!enddb_probe(next[0], next[1], &reply)) {
+            return false;
+        } else if (reply.result == ENDDB_LOSS) {
+            score = 900 - reply.distance;
+        } else if (reply.result == ENDDB_DRAW) {
+            score = 0;
+        } else {
+            score = -900 + reply.distance;
+        }
+
+        if (score > best_score) {
+            best_score = score;
+            best_cell = cell;
+        }
+    }
+
+    if (best_cell < 0) return false;
+    move->row = (uint8_t)(best_cell / ENDDB_SIZE);
+    move->col = (uint8_t)(best_cell % ENDDB_SIZE);
+    if (entry) *entry = here;
+    return true;
+}
@@ -0,0 +1,53 @@
+#ifndef ENDDB_H
+#define ENDDB_H
+
+#include "game.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Solved 4x4 (four in a row) database. Every position with a legal stone
+ * count has a dense index (layer by stone count, then colex rank of the X
+ * cells, then of the O cells among the free ones). Only the canonical
+ * position of each symmetry class is stored; a bitmap over the dense
+ * indices plus a rank directory turns a dense index into a value slot.
+ */
+#define ENDDB_SIZE 4
+#define ENDDB_CELLS (ENDDB_SIZE * ENDDB_SIZE)
+#define ENDDB_INVALID_INDEX 0xFFFFFFFFu
+#define ENDDB_DEFAULT_FILE "enddb_4x4.bin"
+
+/* Outcome for the side to move. */
+typedef enum {
+    ENDDB_UNKNOWN,
+    ENDDB_WIN,
+    ENDDB_LOSS,
+    ENDDB_DRAW
+} EndDbResult;
+
+/* Value byte: result in bits 0..1, plies to the end of the game in 2..7. */
+#define ENDDB_VALUE(result, distance) ((uint8_t)((result) | ((distance) << 2)))
+#define ENDDB_VALUE_RESULT(value) ((EndDbResult)((value) & 0x3u))
+#define ENDDB_VALUE_DISTANCE(value) ((uint8_t)((value) >> 2))
+
+typedef struct {
+    EndDbResult result;
+    uint8_t distance;
+} EndDbEntry;
+
+void enddb_init(void);
+uint32_t enddb_position_count(void);
+uint32_t enddb_layer_start(int stones);
+uint32_t enddb_index(uint16_t x, uint16_t o);
+bool enddb_unrank(uint32_t index, uint16_t* x, uint16_t* o);
+void enddb_canonical(uint16_t x, uint16_t o, uint16_t* cx, uint16_t* co);
+bool enddb_write(const char* path, const uint8_t* values);
+
+bool enddb_open(const char* path);
+void enddb_close(void);
+bool enddb_is_open(void);
+bool enddb_probe(uint16_t x, uint16_t o, EndDbEntry* entry);
+bool enddb_best_move(const Game* game, Move* move, EndDbEntry* entry);
+
+#endif
@@ -1,4 +1,7 @@
 #include "game.h"
+#include "rng.h"
+#include "zobrist.h"
+#include "symmetry.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -14,14 +17,27 @@ void game_init(Game* game, uint8_t size, GameMode mode) {
     game->time_remaining = 30;
     game->symbol_x = 'X';
     game->symbol_o = 'O';
+    game->win_length = game_default_win_length(game->size);
+    game->win_kernel = bitboard_win_kernel(game->size, game->win_length);
+    zobrist_init();
+    symmetry_init();
+    game->hash = zobrist_rules(game->size, game->win_length);
+    game->seed = rng_entropy_seed();
     
     for (int i = 0; i < 4; i++) {
         game->win_line[i] = -1;
     }
 }
 
+void game_set_seed(Game* game, uint64_t seed) {
+    if (!game) return;
+    game->seed = seed;
+}
+
 void game_reset(Game* game) {
     memset(game->board, 0, sizeof(game->board));
+    lineboard_clear(&game->lines);
+    game->hash = zobrist_rules(game->size, game->win_length);
     game->current_player = PLAYER_X;
     game->player_symbol = PLAYER_X;
     game->state = GAME_STATE_PLAYING;
@@ -38,6 +54,33 @@ void game_reset(Game* game) {
     }
 }
 
+uint8_t game_default_win_length(uint8_t size) {
+    if (size <= 3) return 3;
+    if (size <= 5) return 4;
+    return 5;
+}
+
+void game_set_win_length(Game* game, uint8_t win_length) {
+    if (!game) return;
+    if (win_length == 0) win_length = game_default_win_length(game->size);
+    if (win_length < MIN_WIN_LENGTH) win_length = MIN_WIN_LENGTH;
+    if (win_length > game->size) win_length = game->size;
+
+    game->hash ^= zobrist_rules(game->size, game->win_length) ^ zobrist_rules(game->size, win_length);
+    game->win_length = win_length;
+    game->win_kernel = bitboard_win_kernel(game->size, win_length);
+}
+
+uint8_t game_next_board_size(uint8_t size) {
+    static const uint8_t presets[] = {3, 4, 5, 15, 19};
+    const int count = (int)(sizeof(presets) / sizeof(presets[0]));
+
+    for (int i = 0; i < count; i++) {
+        if (presets[i] > size) return presets[i];
+    }
+    return presets[0];
+}
+
 void game_clear_history(Game* game) {
     game->history_count = 0;
     game->undo_count = 0;
@@ -56,10 +99,8 @@ bool game_make_move(Game* game, uint8_t row, uint8_t col) {
         return false;
     }
     
-    if (game->undo_count > 0) {
-        game->history_count -= game->undo_count;
-        game->undo_count = 0;
-    }
+    /* Undo already rewound history_count; a new move drops the redo tail. */
+    game->undo_count = 0;
     
     if (game->history_count < MAX_MOVES) {
         game->move_history[game->history_count].row = row;
@@ -68,10 +109,9 @@ bool game_make_move(Game* game, uint8_t row, uint8_t col) {
         game->history_count++;
     }
     
-    game->board[row][col] = game->current_player;
-    game->move_count++;
+    game_set_cell(game, row, col, game->current_player);
     
-    Player winner = game_check_winner(game);
+    Player winner = game_check_winner_at(game, row, col);
     
     if (winner != PLAYER_NONE) {
         game->state = GAME_STATE_WIN;
@@ -87,76 +127,166 @@ bool game_make_move(Game* game, uint8_t row, uint8_t col) {
     return true;
 }
 
+void game_set_cell(Game* game, uint8_t row, uint8_t col, Player player) {
+    const int index = row * game->size + col;
+    const Player previous = (Player)game->board[row][col];
+
+    if (previous != PLAYER_NONE) {
+        lineboard_remove(&game->lines, previous - 1, row, col);
+        game->hash ^= zobrist_cell(previous, index);
+        game->move_count--;
+    }
+    if (player != PLAYER_NONE) {
+        lineboard_place(&game->lines, player - 1, row, col);
+        game->hash ^= zobrist_cell(player, index);
+        game->move_count++;
+    }
+    game->board[row][col] = (uint8_t)player;
+}
+
+static Bitboard game_stones(const Game* game, Player player) {
+    Bitboard stones = 0;
+    for (uint8_t r = 0; r < game->size; r++) {
+        stones |= (Bitboard)game->lines.rows[player - 1][r] << (r * game->size);
+    }
+    return stones;
+}
+
 Player game_check_winner(Game* game) {
-    const uint8_t n = game->size;
-    const uint8_t win_len = (n == 3) ? 3 : 4;
-    
     for (int i = 0; i < 4; i++) {
         game->win_line[i] = -1;
     }
     
-    static const int8_t dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
-    
-    for (uint8_t r = 0; r < n; r++) {
-        for (uint8_t c = 0; c < n; c++) {
-            const Player p = game->board[r][c];
-            if (p == PLAYER_NONE) continue;
-            
-            for (int d = 0; d < 4; d++) {
-                const int8_t dr = dirs[d][0];
-                const int8_t dc = dirs[d][1];
-                
-                uint8_t count = 1;
-                int8_t sr = r, sc = c, er = r, ec = c;
-                
-                int8_t nr = r + dr;
-                int8_t nc = c + dc;
-                while (nr >= 0 && nr < n && nc >= 0 && nc < n && game->board[nr][nc] == p) {
-                    count++;
-                    er = nr;
-                    ec = nc;
-                    nr += dr;
-                    nc += dc;
-                }
-                
-                nr = r - dr;
-                nc = c - dc;
-                while (nr >= 0 && nr < n && nc >= 0 && nc < n && game->board[nr][nc] == p) {
-                    count++;
-                    sr = nr;
-                    sc = nc;
-                    nr -= dr;
-                    nc -= dc;
-                }
-                
-                if (count >= win_len) {
-                    game->win_line[0] = sr;
-                    game->win_line[1] = sc;
-                    game->win_line[2] = er;
-                    game->win_line[3] = ec;
-                    return p;
-                }
-            }
+    for (Player p = PLAYER_X; p <= PLAYER_O; p++) {
+        if (game->win_kernel && !game->win_kernel(game_stones(game, p))) continue;
+        if (lineboard_find_run(&game->lines, p - 1, game->size, game->win_length, game->win_line)) {
+            return p;
         }
     }
     
+    for (int i = 0; i < 4; i++) {
+        game->win_line[i] = -1;
+    }
     return PLAYER_NONE;
 }
 
+Player game_check_winner_at(Game* game, uint8_t row, uint8_t col) {
+    for (int i = 0; i < 4; i++) {
+        game->win_line[i] = -1;
+    }
+
+    if (row >= game->size || col >= game->size) return PLAYER_NONE;
+
+    const Player p = (Player)game->board[row][col];
+    if (p == PLAYER_NONE) return PLAYER_NONE;
+
+    int8_t line[4];
+    if (lineboard_run_at(&game->lines, p - 1, game->size, row, col, line) < game->win_length) {
+        return PLAYER_NONE;
+    }
+
+    memcpy(game->win_line, line, sizeof(line));
+    return p;
+}
+
 bool game_is_board_full(Game* game) {
+    return game->move_count >= game->size * game->size;
+}
+
+static uint32_t empty_row(const Game* game, uint8_t row) {
+    const uint32_t full = (1u << game->size) - 1u;
+    return ~(game->lines.rows[0][row] | game->lines.rows[1][row]) & full;
+}
+
+Bitboard game_empty_mask(const Game* game) {
+    if (!game || game->size > BITBOARD_MAX_SIZE) return 0;
+
+    Bitboard empty = 0;
+    for (uint8_t r = 0; r < game->size; r++) {
+        empty |= (Bitboard)empty_row(game, r) << (r * game->size);
+    }
+    return empty;
+}
+
+enum {
+    MOVE_TIER_OTHER,
+    MOVE_TIER_CORNER,
+    MOVE_TIER_CENTRE,
+    MOVE_TIER_BLOCK,
+    MOVE_TIER_WIN,
+    MOVE_TIER_COUNT
+};
+
+static uint8_t move_tier(const Game* game, uint8_t row, uint8_t col) {
     const uint8_t n = game->size;
-    for (uint8_t i = 0; i < n; i++) {
-        for (uint8_t j = 0; j < n; j++) {
-            if (game->board[i][j] == PLAYER_NONE) {
-                return false;
-            }
+    const int side = game->current_player - 1;
+
+    if (lineboard_run_at(&game->lines, side, n, row, col, NULL) >= game->win_length) {
+        return MOVE_TIER_WIN;
+    }
+    if (lineboard_run_at(&game->lines, side ^ 1, n, row, col, NULL) >= game->win_length) {
+        return MOVE_TIER_BLOCK;
+    }
+    if (row >= (n - 1) / 2 && row <= n / 2 && col >= (n - 1) / 2 && col <= n / 2) {
+        return MOVE_TIER_CENTRE;
+    }
+    if ((row == 0 || row == n - 1) && (col == 0 || col == n - 1)) {
+        return MOVE_TIER_CORNER;
+    }
+    return MOVE_TIER_OTHER;
+}
+
+int game_generate_moves(const Game* game, MoveList* list) {
+    if (!list) return 0;
+    list->count = list->wins = list->blocks = list->preferred = 0;
+    if (!game || (game->state != GAME_STATE_PLAYING && game->state != GAME_STATE_WAITING)) return 0;
+
+    const uint8_t n = game->size;
+    uint8_t tiers[MAX_MOVES];
+    int tier_counts[MOVE_TIER_COUNT] = {0};
+    int total = 0;
+
+    for (uint8_t r = 0; r < n; r++) {
+        uint32_t empty = empty_row(game, r);
+        while (empty) {
+            const uint8_t c = (uint8_t)bitboard_lsb(empty);
+            empty &= empty - 1;
+            const uint8_t tier = move_tier(game, r, c);
+            list->cells[total] = (uint16_t)(r * n + c);
+            tiers[total++] = tier;
+            tier_counts[tier]++;
         }
     }
-    return true;
+
+    int next[MOVE_TIER_COUNT];
+    int offset = 0;
+    for (int t = MOVE_TIER_COUNT - 1; t >= 0; t--) {
+        next[t] = offset;
+        offset += tier_counts[t];
+    }
+
+    uint16_t ordered[MAX_MOVES];
+    for (int i = 0; i < total; i++) {
+        ordered[next[tiers[i]]++] = list->cells[i];
+    }
+    memcpy(list->cells, ordered, sizeof(ordered[0]) * (size_t)total);
+
+    list->count = total;
+    list->wins = tier_counts[MOVE_TIER_WIN];
+    list->blocks = tier_counts[MOVE_TIER_BLOCK];
+    list->preferred = tier_counts[MOVE_TIER_CENTRE] + tier_counts[MOVE_TIER_CORNER];
+    return total;
+}
+
+static void set_current_player(Game* game, Player player) {
+    if (game->current_player != player) {
+        game->hash ^= zobrist_side();
+    }
+    game->current_player = player;
 }
 
 void game_switch_player(Game* game) {
-    game->current_player = (game->current_player == PLAYER_X) ? PLAYER_O : PLAYER_X;
+    set_current_player(game, (game->current_player == PLAYER_X) ? PLAYER_O : PLAYER_X);
 }
 
 char game_get_cell_char(const Game* game, uint8_t row, uint8_t col) {
@@ -169,7 +299,7 @@ char game_get_cell_char(const Game* game, uint8_t row, uint8_t col) {
 bool game_undo(Game* game) {
     if (game->history_count == 0) return false;
     if (game->state != GAME_STATE_PLAYING) return false;
-    if (game->mode >= MODE_AI_EASY && game->mode <= MODE_AI_HARD) {
+    if (game_mode_is_ai(game->mode)) {
         if (game->move_count <= 1) return false;
     }
     
@@ -180,9 +310,8 @@ bool game_undo(Game* game) {
     const uint8_t col = game->move_history[game->history_count].col;
     const Player player = game->move_history[game->history_count].player;
     
-    game->board[row][col] = PLAYER_NONE;
-    game->move_count--;
-    game->current_player = player;
+    game_set_cell(game, row, col, PLAYER_NONE);
+    set_current_player(game, player);
     game->state = GAME_STATE_PLAYING;
     
     for (int i = 0; i < 4; i++) {
@@ -200,12 +329,11 @@ bool game_redo(Game* game) {
     const uint8_t col = game->move_history[game->history_count].col;
     const Player player = game->move_history[game->history_count].player;
     
-    game->board[row][col] = player;
-    game->move_count++;
+    game_set_cell(game, row, col, player);
     game->history_count++;
     game->undo_count--;
     
-    const Player winner = game_check_winner(game);
+    const Player winner = game_check_winner_at(game, row, col);
     if (winner != PLAYER_NONE) {
         game->state = GAME_STATE_WIN;
     } else if (game_is_board_full(game)) {
@@ -220,7 +348,7 @@ bool game_redo(Game* game) {
 bool game_can_undo(Game* game) {
     if (game->history_count == 0) return false;
     if (game->state != GAME_STATE_PLAYING) return false;
-    if (game->mode >= MODE_AI_EASY && game->mode <= MODE_AI_HARD) {
+    if (game_mode_is_ai(game->mode)) {
         return game->move_count > 1;
     }
     return true;
@@ -249,7 +377,7 @@ bool game_update_timer(Game* game) {
     
     if (game->time_remaining <= 0) {
         game->state = GAME_STATE_WIN;
-        game->current_player = (game->current_player == PLAYER_X) ? PLAYER_O : PLAYER_X;
+        game_switch_player(game);
         return true;
     }
     
@@ -260,9 +388,53 @@ int game_get_timer_remaining(Game* game) {
     return game->time_remaining;
 }
 
+bool game_mode_is_ai(GameMode mode) {
+    return (mode >= MODE_AI_EASY && mode <= MODE_AI_HARD) || mode == MODE_AI_MCTS;
+}
+
 Player game_get_winner(const Game* game) {
     if (!game || game->state != GAME_STATE_WIN) {
         return PLAYER_NONE;
     }
     return game->current_player;
 }
+
+uint64_t game_hash(const Game* game) {
+    return game ? game->hash : 0;
+}
+
+uint64_t game_canonical_key(const Game* game, uint8_t* transform) {
+    if (transform) *transform = SYMMETRY_IDENTITY;
+    if (!game) return 0;
+
+    const uint8_t n = game->size;
+    const uint16_t* maps[SYMMETRY_COUNT];
+    uint64_t keys[SYMMETRY_COUNT];
+    uint64_t base = zobrist_rules(n, game->win_length);
+    if (game->current_player == PLAYER_O) {
+        base ^= zobrist_side();
+    }
+
+    for (int t = 0; t < SYMMETRY_COUNT; t++) {
+        maps[t] = symmetry_cell_map(n, (Symmetry)t);
+        keys[t] = base;
+    }
+
+    for (uint8_t r = 0; r < n; r++) {
+        for (uint8_t c = 0; c < n; c++) {
+            const Player p = (Player)game->board[r][c];
+            if (p == PLAYER_NONE) continue;
+            const int cell = r * n + c;
+            for (int t = 0; t < SYMMETRY_COUNT; t++) {
+                keys[t] ^= zobrist_cell(p, maps[t][cell]);
+            }
+        }
+    }
+
+    int best = SYMMETRY_IDENTITY;
+    for (int t = 1; t < SYMMETRY_COUNT; t++) {
+        if (keys[t] < keys[best]) best = t;
+    }
+    if (transform) *transform = (uint8_t)best;
+    return keys[best];
+}
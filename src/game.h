@@ -3,10 +3,13 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "lineboard.h"
+#include "bitboard.h"
 
-#define MAX_BOARD_SIZE 5
+#define MAX_BOARD_SIZE LINEBOARD_MAX_SIZE
 #define MIN_BOARD_SIZE 3
-#define MAX_MOVES 25
+#define MAX_MOVES (MAX_BOARD_SIZE * MAX_BOARD_SIZE)
+#define MIN_WIN_LENGTH 3
 #define MAX_UNDO_HISTORY 10
 
 typedef enum {
@@ -28,7 +31,8 @@ typedef enum {
     MODE_AI_MEDIUM,
     MODE_AI_HARD,
     MODE_NETWORK_HOST,
-    MODE_NETWORK_CLIENT
+    MODE_NETWORK_CLIENT,
+    MODE_AI_MCTS
 } GameMode;
 
 typedef struct {
@@ -37,9 +41,24 @@ typedef struct {
     Player player;
 } Move;
 
+/* Legal moves as row * size + col, ordered: wins for the side to move,
+ * then blocks, then centre and corner cells, then the rest. */
+typedef struct {
+    uint16_t cells[MAX_MOVES];
+    int count;
+    int wins;
+    int blocks;
+    int preferred;
+} MoveList;
+
 typedef struct {
     uint8_t board[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
+    LineBoard lines;
+    uint64_t hash;
+    uint64_t seed;              /* drives the AI's random choices */
     uint8_t size;
+    uint8_t win_length;
+    BitboardWinKernel win_kernel;
     Player current_player;
     Player player_symbol;
     GameState state;
@@ -59,10 +78,21 @@ typedef struct {
 } Game;
 
 void game_init(Game* game, uint8_t size, GameMode mode);
+bool game_mode_is_ai(GameMode mode);
 void game_reset(Game* game);
+uint8_t game_default_win_length(uint8_t size);
+void game_set_win_length(Game* game, uint8_t win_length);
+/* Games start from a fresh seed; set one (ai_seed in the config, or a
+ * replay's recorded seed) to replay the AI's choices. */
+void game_set_seed(Game* game, uint64_t seed);
+uint8_t game_next_board_size(uint8_t size);
 bool game_make_move(Game* game, uint8_t row, uint8_t col);
+void game_set_cell(Game* game, uint8_t row, uint8_t col, Player player);
 Player game_check_winner(Game* game);
+Player game_check_winner_at(Game* game, uint8_t row, uint8_t col);
 bool game_is_board_full(Game* game);
+Bitboard game_empty_mask(const Game* game);
+int game_generate_moves(const Game* game, MoveList* list);
 void game_switch_player(Game* game);
 char game_get_cell_char(const Game* game, uint8_t row, uint8_t col);
 bool game_undo(Game* game);
@@ -75,5 +105,10 @@ bool game_update_timer(Game* game);
 int game_get_timer_remaining(Game* game);
 void game_clear_history(Game* game);
 Player game_get_winner(const Game* game);
+uint64_t game_hash(const Game* game);
+/* Smallest hash over the eight board symmetries. `transform` receives the
+ * Symmetry that maps this board onto the canonical one; map canonical moves
+ * back with symmetry_inverse(). */
+uint64_t game_canonical_key(const Game* game, uint8_t* transform);
 
 #endif
@@ -25,6 +25,10 @@ bool gui_run_app(Config* cfg, Score* score, Sound* sound) {
     return false;
 }
 
+void gui_show_ai_stats(bool show) {
+    (void)show;
+}
+
 void gui_draw_board(Game* game, SDL_Renderer* renderer, SDL_Texture* font_texture) {
     (void)game;
     (void)renderer;
@@ -46,6 +50,7 @@ void gui_draw_game_over(Game* game, SDL_Renderer* renderer) {
 
 #include "app_meta.h"
 #include "ai.h"
+#include "monotime.h"
 #include "network.h"
 
 #include <SDL2/SDL.h>
@@ -126,6 +131,16 @@ typedef struct {
 
     uint32_t ai_tick;
     uint32_t timer_tick;
+    bool ai_thinking;
+    bool show_stats;
+    bool has_stats;
+    AiStats stats;
+    bool show_hints;
+    bool hint_pending;
+    bool has_hints;
+    uint64_t hint_hash;
+    AiMoveAnalysis hints[MAX_MOVES];
+    int hint_count;
 
     Network net;
     bool net_init;
@@ -156,6 +171,7 @@ static TTF_Font* g_font_small = NULL;
 static TTF_Font* g_font_big = NULL;
 static GUIState* g_gui = NULL;
 static App g_app;
+static bool g_show_ai_stats = false;
 
 static const char* const MAIN_OPTIONS[] = {
     "Play vs AI",
@@ -167,7 +183,7 @@ static const char* const MAIN_OPTIONS[] = {
     "Quit Game"
 };
 
-static const char* const AI_OPTIONS[] = {"Easy AI", "Medium AI", "Hard AI", "Back"};
+static const char* const AI_OPTIONS[] = {"Easy AI", "Medium AI", "Hard AI", "Expert AI", "Back"};
 static const char* const NET_OPTIONS[] = {"Host Game", "Join Game", "Back"};
 
 static int clamp_i(int v, int lo, int hi) {
@@ -324,6 +340,13 @@ static void close_network(App* a) {
 static void apply_cfg_to_game(Game* g, const Config* cfg) {
     if (!g || !cfg) return;
 
+    game_set_win_length(g, (uint8_t)cfg->win_length);
+    ai_set_hash_size((size_t)cfg->ai_hash_mb);
+    ai_set_threads(cfg->ai_threads);
+    ai_set_playouts(cfg->ai_playouts);
+    ai_set_solver_size((size_t)cfg->ai_solver_mb);
+    if (cfg->ai_seed != 0) game_set_seed(g, cfg->ai_seed);
+
     if (cfg->timer_enabled && cfg->timer_seconds > 0) {
         game_start_timer(g, cfg->timer_seconds);
     } else {
@@ -333,15 +356,25 @@ static void apply_cfg_to_game(Game* g, const Config* cfg) {
     g->player_symbol = (cfg->player_symbol == 'O') ? PLAYER_O : PLAYER_X;
 }
 
+/* Also stops a ponder or hint analysis, which run without setting ai_thinking. */
+static void cancel_ai(App* a) {
+    ai_cancel();
+    a->ai_thinking = false;
+    a->hint_pending = false;
+}
+
 static void start_game(App* a, GameMode mode) {
     if (!a || !a->cfg) return;
 
+    cancel_ai(a);
     game_init(&a->game, (uint8_t)a->cfg->board_size, mode);
     apply_cfg_to_game(&a->game, a->cfg);
 
     a->game_active = true;
     a->game_result_done = false;
     a->game_network = false;
+    a->has_stats = false;
+    a->has_hints = false;
     a->ai_tick = SDL_GetTicks() + 350;
     a->timer_tick = SDL_GetTicks();
     a->screen = SCREEN_GAME;
@@ -405,7 +438,7 @@ static BoardLayout board_layout(const Game* g) {
     if (px > 500) px = 500;
     if (px < 240) px = 240;
 
-    int cell = clamp_i(px / g->size, 50, 160);
+    int cell = clamp_i(px / g->size, 16, 160);
     px = cell * g->size;
 
     b.size = px;
@@ -496,10 +529,10 @@ static void draw_main(const GuiTheme* th) {
 }
 
 static void draw_ai(const GuiTheme* th) {
-    Button b[4];
-    layout_buttons(AI_OPTIONS, 4, 230, b);
+    Button b[5];
+    layout_buttons(AI_OPTIONS, 5, 230, b);
     draw_base(th, "Select AI Difficulty");
-    for (int i = 0; i < 4; i++) draw_button(th, &b[i], i == g_app.sel_ai);
+    for (int i = 0; i < 5; i++) draw_button(th, &b[i], i == g_app.sel_ai);
 }
 
 static void draw_network(const GuiTheme* th) {
@@ -666,21 +699,102 @@ static const char* mode_name(const Game* g) {
         case MODE_AI_EASY: return "Easy AI";
         case MODE_AI_MEDIUM: return "Medium AI";
         case MODE_AI_HARD: return "Hard AI";
+        case MODE_AI_MCTS: return "Expert AI";
         case MODE_NETWORK_HOST: return "LAN Host";
         case MODE_NETWORK_CLIENT: return "LAN Client";
         default: return "Two Player Local";
     }
 }
 
+static void draw_ai_stats(const GuiTheme* th, const AiStats* st) {
+    TTF_Font* font = g_font_small ? g_font_small : g_font;
+    SDL_Rect box = {12, PANEL_Y + 40, 250, 150};
+    char line[96];
+    int y = box.y + 8;
+
+    SDL_SetRenderDrawBlendMode(g_renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(g_renderer, 10, 14, 20, 190);
+    SDL_RenderFillRect(g_renderer, &box);
+
+    (void)snprintf(line, sizeof(line), "%s%s", ai_source_name(st->source), st->ponder_hit ? " (ponder hit)" : "");
+    draw_text_line(font, line, box.x + 8, y, th->accent, false);
+    y += 20;
+    (void)snprintf(line, sizeof(line), "%llu nodes, %llu ms", (unsigned long long)st->nodes,
+                   (unsigned long long)st->elapsed_ms);
+    draw_text_line(font, line, box.x + 8, y, th->text, false);
+    y += 20;
+    (void)snprintf(line, sizeof(line), "%llu nodes/s", (unsigned long long)st->nodes_per_sec);
+    draw_text_line(font, line, box.x + 8, y, th->text, false);
+    y += 20;
+    (void)snprintf(line, sizeof(line), "depth %d, ply %d, score %d", st->depth, st->max_ply, st->score);
+    draw_text_line(font, line, box.x + 8, y, th->text, false);
+    y += 20;
+    (void)snprintf(line, sizeof(line), "tt %llu / %llu", (unsigned long long)st->tt_hits,
+                   (unsigned long long)st->tt_probes);
+    draw_text_line(font, line, box.x + 8, y, th->text, false);
+    y += 20;
+
+    int len = snprintf(line, sizeof(line), "pv");
+    for (int i = 0; i < st->pv_length && len > 0 && len < (int)sizeof(line) - 8; i++) {
+        len += snprintf(line + len, sizeof(line) - (size_t)len, " %u,%u", st->pv[i].row + 1, st->pv[i].col + 1);
+    }
+    draw_text_line(font, line, box.x + 8, y, th->muted, false);
+}
+
+/* Tints each analysed cell: green wins, yellow draws, red loses, and a
+ * red-to-green scale for moves the search left open. The best moves are
+ * outlined. */
+static void draw_move_hints(const GuiTheme* th, const Game* g) {
+    if (g_app.hint_count == 0) return;
+
+    BoardLayout b = board_layout(g);
+    const int best = g_app.hints[0].score;
+    int lo = 0;
+    int hi = 0;
+    bool any_open = false;
+    for (int i = 0; i < g_app.hint_count; i++) {
+        const int s = g_app.hints[i].score;
+        if (g_app.hints[i].verdict != AI_VERDICT_UNKNOWN) continue;
+        if (!any_open || s < lo) lo = s;
+        if (!any_open || s > hi) hi = s;
+        any_open = true;
+    }
+
+    SDL_SetRenderDrawBlendMode(g_renderer, SDL_BLENDMODE_BLEND);
+    for (int i = 0; i < g_app.hint_count; i++) {
+        const AiMoveAnalysis* h = &g_app.hints[i];
+        SDL_Rect cell = {b.x + h->move.col * b.cell + 4, b.y + h->move.row * b.cell + 4, b.cell - 8, b.cell - 8};
+        SDL_Color c;
+        if (h->verdict == AI_VERDICT_WIN) c = (SDL_Color){80, 220, 120, 110};
+        else if (h->verdict == AI_VERDICT_DRAW) c = (SDL_Color){235, 200, 80, 90};
+        else if (h->verdict == AI_VERDICT_LOSS) c = (SDL_Color){240, 90, 90, 90};
+        else {
+            const int t = (hi > lo) ? (h->score - lo) * 255 / (hi - lo) : 255;
+            c = (SDL_Color){(uint8_t)(240 - t * 160 / 255), (uint8_t)(90 + t * 130 / 255), 100, 80};
+        }
+        SDL_SetRenderDrawColor(g_renderer, c.r, c.g, c.b, c.a);
+        SDL_RenderFillRect(g_renderer, &cell);
+
+        if (h->score == best) {
+            SDL_SetRenderDrawColor(g_renderer, th->accent.r, th->accent.g, th->accent.b, 255);
+            SDL_RenderDrawRect(g_renderer, &cell);
+        }
+    }
+}
+
 static void draw_game(const GuiTheme* th) {
     char line[96];
     draw_base(th, mode_name(&g_app.game));
 
     draw_board(th, &g_app.game);
+    if (g_app.show_hints && g_app.has_hints && g_app.hint_hash == g_app.game.hash &&
+        g_app.game.state == GAME_STATE_PLAYING && !g_app.ai_thinking) {
+        draw_move_hints(th, &g_app.game);
+    }
 
     if (g_app.game.state == GAME_STATE_PLAYING || g_app.game.state == GAME_STATE_WAITING) {
         char symbol = (g_app.game.current_player == PLAYER_X) ? g_app.game.symbol_x : g_app.game.symbol_o;
-        (void)snprintf(line, sizeof(line), "%c's turn", symbol);
+        (void)snprintf(line, sizeof(line), g_app.ai_thinking ? "%c is thinking..." : "%c's turn", symbol);
         draw_text_line(g_font, line, WINDOW_WIDTH / 2, 124, g_app.game.current_player == PLAYER_X ? th->x_color : th->o_color, true);
     }
 
@@ -689,8 +803,14 @@ static void draw_game(const GuiTheme* th) {
         draw_text_line(g_font_small ? g_font_small : g_font, line, WINDOW_WIDTH / 2, 148, th->muted, true);
     }
 
+    if (g_app.show_stats && g_app.has_stats && game_mode_is_ai(g_app.game.mode)) {
+        draw_ai_stats(th, &g_app.stats);
+    }
+
     draw_text_line(g_font_small ? g_font_small : g_font,
-                   "Click cell to move | Esc main menu",
+                   game_mode_is_ai(g_app.game.mode) ? "Click cell to move | U undo | I stats | H hints | Esc main menu"
+                   : g_app.game_network             ? "Click cell to move | Esc main menu"
+                                                    : "Click cell to move | H hints | Esc main menu",
                    WINDOW_WIDTH / 2,
                    WINDOW_HEIGHT - 84,
                    th->muted,
@@ -764,6 +884,7 @@ static void set_screen(GuiScreen s) {
 }
 
 static void back_to_main_from_game(void) {
+    cancel_ai(&g_app);
     if (g_app.game_network) {
         close_network(&g_app);
     }
@@ -772,6 +893,22 @@ static void back_to_main_from_game(void) {
     set_screen(SCREEN_MAIN);
 }
 
+/* Takes back the player's last move, and the AI's reply if it already
+ * played; a search still thinking about that reply is dropped. */
+static void undo_ai_move(void) {
+    if (!game_mode_is_ai(g_app.game.mode)) return;
+
+    const bool ai_to_move = g_app.game.current_player != g_app.game.player_symbol;
+    cancel_ai(&g_app);
+    if (!ai_to_move && !game_undo(&g_app.game)) return;
+    if (!game_undo(&g_app.game)) {
+        if (g_app.sound) sound_play(g_app.sound, SOUND_INVALID);
+        return;
+    }
+    if (g_app.sound) sound_play(g_app.sound, SOUND_MENU);
+    g_app.ai_tick = SDL_GetTicks() + 360;
+}
+
 static void restart_game_non_network(void) {
     GameMode mode = g_app.game.mode;
     start_game(&g_app, mode);
@@ -784,9 +921,7 @@ static void cycle_setting(int idx) {
     if (!g_app.cfg) return;
 
     if (idx == 0) {
-        int next = g_app.cfg->board_size + 1;
-        if (next > MAX_BOARD_SIZE) next = MIN_BOARD_SIZE;
-        g_app.cfg->board_size = next;
+        g_app.cfg->board_size = game_next_board_size((uint8_t)g_app.cfg->board_size);
     } else if (idx == 1) {
         int next = g_app.cfg->color_theme + 1;
         if (next > 3) next = 0;
@@ -829,14 +964,15 @@ static void activate_main(void) {
 static void activate_ai(void) {
     if (g_app.sound) sound_play(g_app.sound, SOUND_MENU);
 
-    if (g_app.sel_ai == 3) {
+    if (g_app.sel_ai == 4) {
         set_screen(SCREEN_MAIN);
         return;
     }
 
     if (g_app.sel_ai == 0) start_game(&g_app, MODE_AI_EASY);
     else if (g_app.sel_ai == 1) start_game(&g_app, MODE_AI_MEDIUM);
-    else start_game(&g_app, MODE_AI_HARD);
+    else if (g_app.sel_ai == 2) start_game(&g_app, MODE_AI_HARD);
+    else start_game(&g_app, MODE_AI_MCTS);
 }
 
 static void activate_network(void) {
@@ -986,9 +1122,9 @@ static void handle_mouse_main(int x, int y) {
 }
 
 static void handle_mouse_ai(int x, int y) {
-    Button b[4];
-    layout_buttons(AI_OPTIONS, 4, 230, b);
-    for (int i = 0; i < 4; i++) {
+    Button b[5];
+    layout_buttons(AI_OPTIONS, 5, 230, b);
+    for (int i = 0; i < 5; i++) {
         if (in_rect(x, y, &b[i].rect)) {
             g_app.sel_ai = i;
             activate_ai();
@@ -1037,7 +1173,7 @@ static void handle_mouse_game(int x, int y) {
     if (!g_app.game_active) return;
     if (!(g_app.game.state == GAME_STATE_PLAYING || g_app.game.state == GAME_STATE_WAITING)) return;
 
-    if (g_app.game.mode >= MODE_AI_EASY && g_app.game.mode <= MODE_AI_HARD &&
+    if (game_mode_is_ai(g_app.game.mode) &&
         g_app.game.current_player != g_app.game.player_symbol) return;
     if (g_app.game_network && g_app.game.current_player != g_app.game.player_symbol) return;
 
@@ -1057,7 +1193,7 @@ static void handle_mouse_game(int x, int y) {
         return;
     }
 
-    if (g_app.game.mode >= MODE_AI_EASY && g_app.game.mode <= MODE_AI_HARD &&
+    if (game_mode_is_ai(g_app.game.mode) &&
         g_app.game.state == GAME_STATE_PLAYING &&
         g_app.game.current_player != g_app.game.player_symbol) {
         g_app.ai_tick = SDL_GetTicks() + 360;
@@ -1094,8 +1230,8 @@ static void handle_key(SDL_Keycode key) {
     }
 
     if (g_app.screen == SCREEN_AI) {
-        if (key == SDLK_UP) g_app.sel_ai = (g_app.sel_ai + 3) % 4;
-        else if (key == SDLK_DOWN) g_app.sel_ai = (g_app.sel_ai + 1) % 4;
+        if (key == SDLK_UP) g_app.sel_ai = (g_app.sel_ai + 4) % 5;
+        else if (key == SDLK_DOWN) g_app.sel_ai = (g_app.sel_ai + 1) % 5;
         else if (key == SDLK_RETURN || key == SDLK_KP_ENTER) activate_ai();
         return;
     }
@@ -1142,6 +1278,12 @@ static void handle_key(SDL_Keycode key) {
             (g_app.game.state == GAME_STATE_WIN || g_app.game.state == GAME_STATE_DRAW)) {
             if (g_app.game_network) back_to_main_from_game();
             else restart_game_non_network();
+        } else if (key == SDLK_u || key == SDLK_BACKSPACE) {
+            undo_ai_move();
+        } else if (key == SDLK_i) {
+            g_app.show_stats = !g_app.show_stats;
+        } else if (key == SDLK_h && !g_app.game_network) {
+            g_app.show_hints = !g_app.show_hints;
         }
     }
 }
@@ -1210,6 +1352,25 @@ static void update_network_wait(void) {
     start_network_game(&g_app, true);
 }
 
+/* Hints rate the human's moves once per position. */
+static bool hints_wanted(void) {
+    if (!g_app.show_hints || g_app.game_network || g_app.game.state != GAME_STATE_PLAYING) return false;
+    if (game_mode_is_ai(g_app.game.mode) && g_app.game.current_player != g_app.game.player_symbol) return false;
+    return !g_app.has_hints || g_app.hint_hash != g_app.game.hash;
+}
+
+/* Drops an analysis the position has moved past or hints were turned off for. */
+static void poll_hints(void) {
+    if (!g_app.show_hints || g_app.hint_hash != g_app.game.hash) {
+        cancel_ai(&g_app);
+        return;
+    }
+    if (ai_poll_analysis(g_app.hints, MAX_MOVES, &g_app.hint_count)) {
+        g_app.hint_pending = false;
+        g_app.has_hints = true;
+    }
+}
+
 static void update_game(void) {
     if (!g_app.game_active) return;
 
@@ -1222,16 +1383,41 @@ static void update_game(void) {
         }
     }
 
-    if (g_app.game.mode >= MODE_AI_EASY && g_app.game.mode <= MODE_AI_HARD &&
-        g_app.game.state == GAME_STATE_PLAYING &&
-        g_app.game.current_player != g_app.game.player_symbol &&
-        SDL_GetTicks() >= g_app.ai_tick) {
+    /* The engine thinks on its own thread; the frame loop only polls. */
+    if (g_app.ai_thinking) {
         Move m;
-        ai_get_move(&g_app.game, &m);
-        if (m.row < g_app.game.size && m.col < g_app.game.size && game_make_move(&g_app.game, m.row, m.col)) {
-            if (g_app.sound) sound_play(g_app.sound, SOUND_MOVE);
+        if (ai_poll_result(&m)) {
+            g_app.ai_thinking = false;
+            ai_last_stats(&g_app.stats);
+            g_app.has_stats = true;
+            if (g_app.game.current_player != g_app.game.player_symbol &&
+                m.row < g_app.game.size && m.col < g_app.game.size && game_make_move(&g_app.game, m.row, m.col)) {
+                if (g_app.sound) sound_play(g_app.sound, SOUND_MOVE);
+            }
+            g_app.ai_tick = SDL_GetTicks() + 500;
         }
-        g_app.ai_tick = SDL_GetTicks() + 500;
+    } else if (g_app.hint_pending) {
+        poll_hints();
+    } else if (game_mode_is_ai(g_app.game.mode) &&
+               g_app.game.state == GAME_STATE_PLAYING &&
+               g_app.game.current_player != g_app.game.player_symbol &&
+               SDL_GetTicks() >= g_app.ai_tick) {
+        const int budget = g_app.cfg ? g_app.cfg->ai_time_ms : AI_DEFAULT_TIME_MS;
+        const uint64_t deadline = budget > 0 ? monotime_ms() + (uint64_t)budget : 0;
+        g_app.ai_thinking = ai_request_move(&g_app.game, deadline);
+    } else if (hints_wanted()) {
+        /* Shares the request thread, so a ponder resumes once hints arrive. */
+        const int budget = g_app.cfg ? g_app.cfg->ai_time_ms : AI_DEFAULT_TIME_MS;
+        const uint64_t deadline = budget > 0 ? monotime_ms() + (uint64_t)budget : 0;
+        g_app.has_hints = false;
+        g_app.hint_hash = g_app.game.hash;
+        g_app.hint_pending = ai_request_analysis(&g_app.game, deadline);
+    } else if (g_app.cfg && g_app.cfg->ai_ponder && game_mode_is_ai(g_app.game.mode) &&
+               g_app.game.state == GAME_STATE_PLAYING &&
+               g_app.game.current_player == g_app.game.player_symbol) {
+        (void)ai_start_ponder(&g_app.game);
+    } else if (ai_is_pondering() && g_app.game.state != GAME_STATE_PLAYING) {
+        cancel_ai(&g_app);
     }
 
     if (g_app.game_network &&
@@ -1310,6 +1496,7 @@ bool gui_init(GUIState* gui) {
 void gui_close(GUIState* gui) {
     (void)gui;
 
+    cancel_ai(&g_app);
     close_network(&g_app);
     enter_text_mode(false);
 
@@ -1332,6 +1519,10 @@ void gui_close(GUIState* gui) {
     SDL_Quit();
 }
 
+void gui_show_ai_stats(bool show) {
+    g_show_ai_stats = show;
+}
+
 bool gui_run_app(Config* cfg, Score* score, Sound* sound) {
     if (!cfg || !score || !g_window || !g_renderer) return false;
 
@@ -1339,6 +1530,7 @@ bool gui_run_app(Config* cfg, Score* score, Sound* sound) {
     g_app.cfg = cfg;
     g_app.score = score;
     g_app.sound = sound;
+    g_app.show_stats = g_show_ai_stats;
     g_app.running = true;
 
     (void)snprintf(g_app.host_port, sizeof(g_app.host_port), "%d", DEFAULT_PORT);
@@ -1360,6 +1552,7 @@ bool gui_run_app(Config* cfg, Score* score, Sound* sound) {
         SDL_Delay(16);
     }
 
+    cancel_ai(&g_app);
     close_network(&g_app);
     enter_text_mode(false);
     return true;
@@ -1394,6 +1587,7 @@ bool gui_run_game(Game* game) {
         SDL_Delay(16);
     }
 
+    cancel_ai(&g_app);
     *game = g_app.game;
     return true;
 }
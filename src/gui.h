@@ -28,6 +28,8 @@ bool gui_init(GUIState* gui);
 void gui_close(GUIState* gui);
 bool gui_run_game(Game* game);
 bool gui_run_app(Config* cfg, Score* score, Sound* sound);
+/* Starts games with the AI search statistics overlay shown (toggled with I). */
+void gui_show_ai_stats(bool show);
 void gui_draw_board(Game* game, SDL_Renderer* renderer, SDL_Texture* font_texture);
 void gui_handle_click(Game* game, int mouse_x, int mouse_y);
 void gui_draw_game_over(Game* game, SDL_Renderer* renderer);
@@ -0,0 +1,128 @@
+#include "lineboard.h"
+#include <string.h>
+
+#define DIAG_INDEX(row, col) ((row) - (col) + LINEBOARD_MAX_SIZE - 1)
+#define ANTI_INDEX(row, col) ((row) + (col))
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+static int lowest_bit(uint32_t v) {
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return (int)index;
+}
+static int highest_bit(uint32_t v) {
+    unsigned long index;
+    _BitScanReverse(&index, v);
+    return (int)index;
+}
+#else
+static int lowest_bit(uint32_t v) {
+    return __builtin_ctz(v);
+}
+static int highest_bit(uint32_t v) {
+    return 31 - __builtin_clz(v);
+}
+#endif
+
+void lineboard_clear(LineBoard* lb) {
+    memset(lb, 0, sizeof(*lb));
+}
+
+void lineboard_place(LineBoard* lb, int side, uint8_t row, uint8_t col) {
+    lb->rows[side][row] |= 1u << col;
+    lb->cols[side][col] |= 1u << row;
+    lb->diags[side][DIAG_INDEX(row, col)] |= 1u << col;
+    lb->antis[side][ANTI_INDEX(row, col)] |= 1u << col;
+}
+
+void lineboard_remove(LineBoard* lb, int side, uint8_t row, uint8_t col) {
+    lb->rows[side][row] &= ~(1u << col);
+    lb->cols[side][col] &= ~(1u << row);
+    lb->diags[side][DIAG_INDEX(row, col)] &= ~(1u << col);
+    lb->antis[side][ANTI_INDEX(row, col)] &= ~(1u << col);
+}
+
+/* Extent of the run of set bits through bit, which is treated as set. */
+static int run_through(uint32_t mask, int bit, int* lo, int* hi) {
+    mask |= 1u << bit;
+
+    const int up = lowest_bit(~(mask >> bit));
+    const uint32_t gaps = ~mask & ((1u << bit) - 1u);
+    const int down = gaps ? bit - 1 - highest_bit(gaps) : bit;
+
+    *lo = bit - down;
+    *hi = bit + up - 1;
+    return up + down;
+}
+
+int lineboard_run_at(const LineBoard* lb, int side, uint8_t size, uint8_t row, uint8_t col, int8_t line[4]) {
+    const uint32_t inside = (1u << size) - 1u;
+    const int r = row;
+    const int c = col;
+    int best = 0;
+    int lo = 0;
+    int hi = 0;
+    int len = 0;
+
+    len = run_through(lb->rows[side][r] & inside, c, &lo, &hi);
+    if (len > best) {
+        best = len;
+        if (line) { line[0] = (int8_t)r; line[1] = (int8_t)lo; line[2] = (int8_t)r; line[3] = (int8_t)hi; }
+    }
+
+    len = run_through(lb->cols[side][c] & inside, r, &lo, &hi);
+    if (len > best) {
+        best = len;
+        if (line) { line[0] = (int8_t)lo; line[1] = (int8_t)c; line[2] = (int8_t)hi; line[3] = (int8_t)c; }
+    }
+
+    len = run_through(lb->diags[side][DIAG_INDEX(r, c)] & inside, c, &lo, &hi);
+    if (len > best) {
+        best = len;
+        if (line) { line[0] = (int8_t)(lo + r - c); line[1] = (int8_t)lo; line[2] = (int8_t)(hi + r - c); line[3] = (int8_t)hi; }
+    }
+
+    len = run_through(lb->antis[side][ANTI_INDEX(r, c)] & inside, c, &lo, &hi);
+    if (len > best) {
+        best = len;
+        if (line) { line[0] = (int8_t)(r + c - lo); line[1] = (int8_t)lo; line[2] = (int8_t)(r + c - hi); line[3] = (int8_t)hi; }
+    }
+
+    return best;
+}
+
+static int run_start(uint32_t mask, uint8_t length) {
+    uint32_t acc = mask;
+    for (uint8_t i = 1; i < length && acc; i++) {
+        acc &= mask >> i;
+    }
+    return acc ? lowest_bit(acc) : -1;
+}
+
+bool lineboard_find_run(const LineBoard* lb, int side, uint8_t size, uint8_t length, int8_t line[4]) {
+    const uint32_t inside = (1u << size) - 1u;
+    int start = -1;
+
+    for (int r = 0; r < size; r++) {
+        start = run_start(lb->rows[side][r] & inside, length);
+        if (start >= 0) return lineboard_run_at(lb, side, size, (uint8_t)r, (uint8_t)start, line) >= length;
+    }
+
+    for (int c = 0; c < size; c++) {
+        start = run_start(lb->cols[side][c] & inside, length);
+        if (start >= 0) return lineboard_run_at(lb, side, size, (uint8_t)start, (uint8_t)c, line) >= length;
+    }
+
+    for (int d = -(size - 1); d <= size - 1; d++) {
+        start = run_start(lb->diags[side][d + LINEBOARD_MAX_SIZE - 1] & inside, length);
+        if (start >= 0) return lineboard_run_at(lb, side, size, (uint8_t)(start + d), (uint8_t)start, line) >= length;
+    }
+
+    for (int a = 0; a <= 2 * (size - 1); a++) {
+        start = run_start(lb->antis[side][a] & inside, length);
+        if (start >= 0) return lineboard_run_at(lb, side, size, (uint8_t)(a - start), (uint8_t)start, line) >= length;
+    }
+
+    return false;
+}
@@ -0,0 +1,28 @@
+#ifndef LINEBOARD_H
+#define LINEBOARD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define LINEBOARD_MAX_SIZE 19
+#define LINEBOARD_DIAGONALS (2 * LINEBOARD_MAX_SIZE - 1)
+
+/*
+ * Per-side stones packed one word per line. Rows, diagonals and
+ * anti-diagonals use the column as bit index, columns use the row, so a
+ * run of set bits is a run of stones along that line.
+ */
+typedef struct {
+    uint32_t rows[2][LINEBOARD_MAX_SIZE];
+    uint32_t cols[2][LINEBOARD_MAX_SIZE];
+    uint32_t diags[2][LINEBOARD_DIAGONALS];
+    uint32_t antis[2][LINEBOARD_DIAGONALS];
+} LineBoard;
+
+void lineboard_clear(LineBoard* lb);
+void lineboard_place(LineBoard* lb, int side, uint8_t row, uint8_t col);
+void lineboard_remove(LineBoard* lb, int side, uint8_t row, uint8_t col);
+int lineboard_run_at(const LineBoard* lb, int side, uint8_t size, uint8_t row, uint8_t col, int8_t line[4]);
+bool lineboard_find_run(const LineBoard* lb, int side, uint8_t size, uint8_t length, int8_t line[4]);
+
+#endif
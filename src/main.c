@@ -1,7 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 #include <ctype.h>
 
 #ifdef _WIN32
@@ -13,6 +12,7 @@
 #include "cli.h"
 #include "game.h"
 #include "ai.h"
+#include "monotime.h"
 #include "network.h"
 #include "internet.h"
 #include "utils.h"
@@ -23,6 +23,7 @@
 static Config global_config;
 static Score global_score;
 static Sound global_sound;
+static bool show_ai_stats = false;
 
 static void get_input(char* buffer, size_t size);
 static void play_local_2p(Game* game);
@@ -31,7 +32,8 @@ static void play_network(Network* net, bool is_host);
 static void play_internet_network(Network* net, bool is_host);
 static void play_network_session(Network* net, bool is_host);
 static bool ensure_cloudflared_ready(void);
-static void run_ai_turn(Game* game);
+static bool run_ai_turn(Game* game);
+static void show_move_hints(const Game* game);
 static void print_welcome_animation(void);
 static void sleep_seconds(unsigned int seconds);
 static void sleep_milliseconds(unsigned int milliseconds);
@@ -49,6 +51,8 @@ int main(int argc, char* argv[]) {
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--gui") == 0 || strcmp(argv[i], "-g") == 0) {
             request_gui = true;
+        } else if (strcmp(argv[i], "--ai-stats") == 0) {
+            show_ai_stats = true;
         } else if (strcmp(argv[i], "--version") == 0 || strcmp(argv[i], "-v") == 0) {
             print_version();
             return 0;
@@ -63,7 +67,6 @@ int main(int argc, char* argv[]) {
     }
 
     cli_init_terminal();
-    srand((unsigned int)time(NULL));
 
     if (!init_data_paths(true)) {
         fprintf(stderr, ANSI_ERROR "\n  Failed to initialize data directory.\n" ANSI_RESET);
@@ -71,6 +74,12 @@ int main(int argc, char* argv[]) {
     }
     
     config_load(&global_config, get_config_path());
+    if (!ai_load_endgame_db(get_endgame_db_path())) {
+        (void)ai_load_endgame_db("enddb_4x4.bin");
+    }
+    if (!ai_load_opening_book(get_opening_book_path())) {
+        (void)ai_load_opening_book("opening_book.bin");
+    }
     score_load(&global_score, get_highscore_path());
     sound_init(&global_sound);
     sound_set_enabled(&global_sound, global_config.sound_enabled);
@@ -114,15 +123,16 @@ int main(int argc, char* argv[]) {
             case 0: {
                 int ai_selection = 0;
                 while (1) {
-                    int ai_choice = run_vertical_menu(cli_print_game_menu, 4, ai_selection);
-                    if (ai_choice < 0 || ai_choice == 3) {
+                    int ai_choice = run_vertical_menu(cli_print_game_menu, 5, ai_selection);
+                    if (ai_choice < 0 || ai_choice == 4) {
                         break;
                     }
 
                     ai_selection = ai_choice;
                     GameMode mode = (ai_choice == 0) ? MODE_AI_EASY
                                   : (ai_choice == 1) ? MODE_AI_MEDIUM
-                                                     : MODE_AI_HARD;
+                                  : (ai_choice == 2) ? MODE_AI_HARD
+                                                     : MODE_AI_MCTS;
 
                     Game game;
                     game_init(&game, (uint8_t)global_config.board_size, mode);
@@ -213,9 +223,7 @@ int main(int argc, char* argv[]) {
                                 current_size = MIN_BOARD_SIZE;
                             }
 
-                            int next_size = current_size + 1;
-                            if (next_size > MAX_BOARD_SIZE) next_size = MIN_BOARD_SIZE;
-                            global_config.board_size = next_size;
+                            global_config.board_size = game_next_board_size((uint8_t)current_size);
                             config_save(&global_config, get_config_path());
                             sound_play(&global_sound, SOUND_MENU);
                         } else if (settings_selection == 1) {
@@ -351,6 +359,10 @@ static void play_local_2p(Game* game) {
             sound_play(&global_sound, SOUND_MENU);
             return;
         }
+        if (toupper(input[0]) == 'H') {
+            show_move_hints(game);
+            continue;
+        }
 
         uint8_t row, col;
         if (!parse_move_input(input, game->size, &row, &col)) {
@@ -387,28 +399,43 @@ static void play_local_2p(Game* game) {
 }
 
 static void play_ai(Game* game, GameMode mode) {
-    const char* mode_names[] = {"Easy", "Medium", "Hard"};
-    int mode_idx = (mode == MODE_AI_EASY) ? 0 : (mode == MODE_AI_MEDIUM) ? 1 : 2;
+    const char* mode_names[] = {"Easy", "Medium", "Hard", "Expert"};
+    int mode_idx = (mode == MODE_AI_EASY) ? 0 : (mode == MODE_AI_MEDIUM) ? 1 : (mode == MODE_AI_HARD) ? 2 : 3;
     
     printf(ANSI_GREEN "\n  Starting " ANSI_YELLOW "%s" ANSI_GREEN " AI game!\n\n" ANSI_RESET, mode_names[mode_idx]);
     sleep_seconds(1);
     
+    bool ai_moved = false;
     while (game->state == GAME_STATE_PLAYING) {
         cli_print_board(game);
+        if (show_ai_stats && ai_moved) {
+            AiStats stats;
+            ai_last_stats(&stats);
+            cli_print_ai_stats(&stats);
+        }
+        ai_moved = false;
         
         if (game->current_player != game->player_symbol) {
-            run_ai_turn(game);
+            ai_moved = run_ai_turn(game);
         } else {
             cli_print_move_prompt();
+            if (global_config.ai_ponder) {
+                (void)ai_start_ponder(game);
+            }
             
             char input[32];
             get_input(input, sizeof(input));
             
             if (toupper(input[0]) == 'Q') {
+                ai_cancel();
                 printf(ANSI_YELLOW "\n  Game aborted!\n" ANSI_RESET);
                 sound_play(&global_sound, SOUND_MENU);
                 return;
             }
+            if (toupper(input[0]) == 'H') {
+                show_move_hints(game);
+                continue;
+            }
 
             uint8_t row, col;
             if (!parse_move_input(input, game->size, &row, &col)) {
@@ -427,8 +454,14 @@ static void play_ai(Game* game, GameMode mode) {
             }
         }
     }
+    ai_cancel();
     
     cli_print_board(game);
+    if (show_ai_stats && ai_moved) {
+        AiStats stats;
+        ai_last_stats(&stats);
+        cli_print_ai_stats(&stats);
+    }
     cli_print_game_over(game);
     
     if (game->state == GAME_STATE_WIN) {
@@ -447,16 +480,37 @@ static void play_ai(Game* game, GameMode mode) {
     get_input(input, sizeof(input));
 }
 
-static void run_ai_turn(Game* game) {
-    cli_print_ai_thinking();
+static bool run_ai_turn(Game* game) {
+    const uint64_t deadline = global_config.ai_time_ms > 0 ? monotime_ms() + (uint64_t)global_config.ai_time_ms : 0;
 
+    /* Search while the thinking animation plays instead of after it. */
     Move ai_move;
-    ai_get_move(game, &ai_move);
+    ai_move.row = game->size;
+    ai_move.col = game->size;
+    if (ai_request_move(game, deadline)) {
+        cli_print_ai_thinking();
+        (void)ai_wait_result(&ai_move);
+    }
     
     if (ai_move.row < game->size && ai_move.col < game->size) {
         game_make_move(game, ai_move.row, ai_move.col);
         sound_play(&global_sound, SOUND_MOVE);
+        return true;
     }
+    return false;
+}
+
+/* Rates every move with the AI's time budget and waits for Enter. */
+static void show_move_hints(const Game* game) {
+    const uint64_t deadline = global_config.ai_time_ms > 0 ? monotime_ms() + (uint64_t)global_config.ai_time_ms : 0;
+    AiMoveAnalysis moves[MAX_MOVES];
+    const int count = ai_analyze_timed(game, deadline, moves, MAX_MOVES);
+
+    cli_print_move_heatmap(game, moves, count);
+    printf("  " ANSI_CYAN "[Enter] Back to the game" ANSI_RESET "\n");
+
+    char input[8];
+    get_input(input, sizeof(input));
 }
 
 static int parse_port_or_default(const char* text, int fallback) {
@@ -783,6 +837,7 @@ static bool launch_gui_mode(void) {
     }
 
     printf(ANSI_BRIGHT_GREEN "\n  Launching GUI mode...\n" ANSI_RESET);
+    gui_show_ai_stats(show_ai_stats);
     if (!gui_run_app(&global_config, &global_score, &global_sound)) {
         gui_close(&gui);
         return false;
@@ -839,8 +894,9 @@ static void sleep_milliseconds(unsigned int milliseconds) {
 static void print_cli_usage(const char* program_name) {
     const char* app = (program_name && program_name[0] != '\0') ? program_name : "tictactoe-cx";
     printf("%s v%s\n", APP_NAME, APP_VERSION);
-    printf("Usage: %s [--gui|-g] [--version|-v] [--help|-h]\n", app);
+    printf("Usage: %s [--gui|-g] [--ai-stats] [--version|-v] [--help|-h]\n", app);
     printf("  --gui, -g      Launch GUI mode when available\n");
+    printf("  --ai-stats     Show search statistics after every AI move\n");
     printf("  --version, -v  Print version and exit\n");
     printf("  --help, -h     Show this help message\n");
 }
@@ -912,6 +968,13 @@ static void apply_config_to_game(Game* game) {
         return;
     }
 
+    game_set_win_length(game, (uint8_t)global_config.win_length);
+    ai_set_hash_size((size_t)global_config.ai_hash_mb);
+    ai_set_threads(global_config.ai_threads);
+    ai_set_playouts(global_config.ai_playouts);
+    ai_set_solver_size((size_t)global_config.ai_solver_mb);
+    if (global_config.ai_seed != 0) game_set_seed(game, global_config.ai_seed);
+
     if (global_config.timer_enabled && global_config.timer_seconds > 0) {
         game_start_timer(game, global_config.timer_seconds);
     } else {
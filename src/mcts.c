@@ -0,0 +1,324 @@
+#include "mcts.h"
+#include "monotime.h"
+#include "rng.h"
+#include "thread.h"
+#include "zobrist.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MCTS_TREE_NODES (1u << 18)
+#define MCTS_NO_NODE 0xFFFFFFFFu
+#define MCTS_NO_CELL 0xFFFF
+#define MCTS_EXPLORATION 1.41421356f
+#define MCTS_EXPAND_VISITS 2
+#define MCTS_CLOCK_INTERVAL 64
+#define MCTS_UNDECIDED (-2)
+#define MCTS_DRAW (-1)
+
+typedef struct {
+    uint32_t first_child;
+    uint16_t child_count;
+    uint16_t cell;
+    uint32_t visits;
+    float reward;           /* for the side that played `cell` */
+} MctsNode;
+
+typedef struct {
+    MctsNode* nodes;
+    uint32_t used;
+    uint32_t root;
+    uint64_t root_hash;
+    int root_history;
+    Rng rng;
+} MctsTree;
+
+/* Playout state: stones as LineBoard words, empty cells as a dense list
+ * so a random move is one index and removal is a swap. */
+typedef struct {
+    LineBoard lines;
+    uint16_t empty[MAX_MOVES];
+    uint16_t slot[MAX_MOVES];
+    int empty_count;
+    uint8_t size;
+    uint8_t win_length;
+    int side;
+} PlayoutBoard;
+
+typedef struct {
+    MctsTree* tree;
+    const PlayoutBoard* start;
+    uint64_t deadline_ms;
+    const volatile int* cancel;
+    uint64_t limit;
+    uint64_t playouts;
+} MctsJob;
+
+static MctsTree g_trees[MCTS_MAX_THREADS];
+
+static void board_from_game(PlayoutBoard* board, const Game* game) {
+    const uint8_t n = game->size;
+
+    board->lines = game->lines;
+    board->size = n;
+    board->win_length = game->win_length;
+    board->side = game->current_player - 1;
+    board->empty_count = 0;
+    for (int cell = 0; cell < n * n; cell++) {
+        if (game->board[cell / n][cell % n] != PLAYER_NONE) continue;
+        board->slot[cell] = (uint16_t)board->empty_count;
+        board->empty[board->empty_count++] = (uint16_t)cell;
+    }
+}
+
+/* Plays `cell` for the side to move; true when that completes a line. */
+static bool board_play(PlayoutBoard* board, int cell) {
+    const uint8_t row = (uint8_t)(cell / board->size);
+    const uint8_t col = (uint8_t)(cell % board->size);
+    const uint16_t last = board->empty[--board->empty_count];
+    const uint16_t at = board->slot[cell];
+
+    board->empty[at] = last;
+    board->slot[last] = at;
+    lineboard_place(&board->lines, board->side, row, col);
+
+    const bool won = lineboard_run_at(&board->lines, board->side, board->size, row, col, NULL) >= board->win_length;
+    board->side ^= 1;
+    return won;
+}
+
+static int board_playout(PlayoutBoard* board, Rng* rng) {
+    while (board->empty_count > 0) {
+        const int mover = board->side;
+        const int cell = board->empty[rng_below(rng, (uint32_t)board->empty_count)];
+        if (board_play(board, cell)) return mover;
+    }
+    return MCTS_DRAW;
+}
+
+static void init_node(MctsNode* node, uint16_t cell) {
+    node->first_child = MCTS_NO_NODE;
+    node->child_count = 0;
+    node->cell = cell;
+    node->visits = 0;
+    node->reward = 0.0f;
+}
+
+static bool tree_reset(MctsTree* tree, const Game* game, int index) {
+    if (!tree->nodes) {
+        tree->nodes = (MctsNode*)malloc(MCTS_TREE_NODES * sizeof(MctsNode));
+        if (!tree->nodes) return false;
+    }
+    rng_seed(&tree->rng, game->seed ^ game->hash ^ ((uint64_t)(index + 1) << 56));
+    tree->used = 1;
+    tree->root = 0;
+    init_node(&tree->nodes[0], MCTS_NO_CELL);
+    tree->root_hash = game->hash;
+    tree->root_history = game->history_count;
+    return true;
+}
+
+static uint32_t find_child(const MctsTree* tree, uint32_t index, uint16_t cell) {
+    const MctsNode* node = &tree->nodes[index];
+    if (node->first_child == MCTS_NO_NODE) return MCTS_NO_NODE;
+    for (uint32_t i = 0; i < node->child_count; i++) {
+        if (tree->nodes[node->first_child + i].cell == cell) return node->first_child + i;
+    }
+    return MCTS_NO_NODE;
+}
+
+/* Moves the root down the moves played since the last search. Fails when
+ * the game is not a continuation of that root or the pool is half used,
+ * since re-rooting never reclaims the abandoned branches. */
+static bool tree_reroot(MctsTree* tree, const Game* game) {
+    if (!tree->nodes || tree->used > MCTS_TREE_NODES / 2) return false;
+    if (tree->root_history > game->history_count) return false;
+
+    uint64_t hash = game->hash;
+    for (int i = game->history_count - 1; i >= tree->root_history; i--) {
+        const Move* m = &game->move_history[i];
+        hash ^= zobrist_cell(m->player, m->row * game->size + m->col) ^ zobrist_side();
+    }
+    if (hash != tree->root_hash) return false;
+
+    uint32_t index = tree->root;
+    for (int i = tree->root_history; i < game->history_count; i++) {
+        const Move* m = &game->move_history[i];
+        index = find_child(tree, index, (uint16_t)(m->row * game->size + m->col));
+        if (index == MCTS_NO_NODE) return false;
+    }
+
+    tree->root = index;
+    tree->root_hash = game->hash;
+    tree->root_history = game->history_count;
+    return true;
+}
+
+static bool expand_node(MctsTree* tree, uint32_t index, const PlayoutBoard* board) {
+    const uint32_t count = (uint32_t)board->empty_count;
+    if (tree->used + count > MCTS_TREE_NODES) return false;
+
+    const uint32_t first = tree->used;
+    tree->used += count;
+    for (uint32_t i = 0; i < count; i++) {
+        init_node(&tree->nodes[first + i], board->empty[i]);
+    }
+    tree->nodes[index].first_child = first;
+    tree->nodes[index].child_count = (uint16_t)count;
+    return true;
+}
+
+/* UCT; unvisited children come first, starting from a random one. */
+static uint32_t select_child(MctsTree* tree, const MctsNode* node) {
+    const uint32_t count = node->child_count;
+    const uint32_t start = rng_below(&tree->rng, count);
+    const float log_parent = logf((float)node->visits);
+    uint32_t best = node->first_child + start;
+    float best_score = -1.0f;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const uint32_t index = node->first_child + (start + i) % count;
+        const MctsNode* child = &tree->nodes[index];
+        if (child->visits == 0) return index;
+
+        const float visits = (float)child->visits;
+        const float score = child->reward / visits + MCTS_EXPLORATION * sqrtf(log_parent / visits);
+        if (score > best_score) {
+            best_score = score;
+            best = index;
+        }
+    }
+    return best;
+}
+
+static void run_job(void* arg) {
+    MctsJob* job = (MctsJob*)arg;
+    MctsTree* tree = job->tree;
+    uint32_t path[MAX_MOVES + 1];
+    PlayoutBoard board;
+
+    for (;;) {
+        if (job->limit && job->playouts >= job->limit) break;
+        if (job->playouts % MCTS_CLOCK_INTERVAL == 0 &&
+            ((job->cancel && *job->cancel) || (job->deadline_ms && monotime_ms() >= job->deadline_ms))) {
+            break;
+        }
+
+        board = *job->start;
+        uint32_t index = tree->root;
+        int depth = 0;
+        int winner = MCTS_UNDECIDED;
+        path[depth++] = index;
+
+        for (;;) {
+            const MctsNode* node = &tree->nodes[index];
+            if (node->first_child == MCTS_NO_NODE) {
+                if (index != tree->root && node->visits < MCTS_EXPAND_VISITS) break;
+                if (!expand_node(tree, index, &board)) break;
+            }
+
+            const int mover = board.side;
+            index = select_child(tree, node);
+            path[depth++] = index;
+            if (board_play(&board, tree->nodes[index].cell)) {
+                winner = mover;
+                break;
+            }
+            if (board.empty_count == 0) {
+                winner = MCTS_DRAW;
+                break;
+            }
+        }
+        if (winner == MCTS_UNDECIDED) {
+            winner = board_playout(&board, &tree->rng);
+        }
+
+        /* path[d] was played by the side to move at the root when d is odd. */
+        for (int d = 0; d < depth; d++) {
+            MctsNode* node = &tree->nodes[path[d]];
+            const int mover = (job->start->side + d + 1) & 1;
+            node->visits++;
+            node->reward += (winner == MCTS_DRAW) ? 0.5f : (winner == mover) ? 1.0f : 0.0f;
+        }
+        job->playouts++;
+    }
+}
+
+bool mcts_best_move(const Game* game, const MctsBudget* budget, Move* move, uint64_t* playouts) {
+    if (playouts) *playouts = 0;
+    if (!game || !budget || !move) return false;
+
+    MoveList moves;
+    if (game_generate_moves(game, &moves) == 0) return false;
+
+    const uint8_t n = game->size;
+    int best = moves.cells[0];
+
+    /* A win, or a block, is not worth sampling. */
+    if (moves.wins + moves.blocks == 0) {
+        int threads = budget->threads;
+        if (threads < 1) threads = 1;
+        if (threads > MCTS_MAX_THREADS) threads = MCTS_MAX_THREADS;
+
+        uint64_t limit = (budget->playouts > 0) ? (uint64_t)budget->playouts : 0;
+        if (limit == 0 && budget->deadline_ms == 0) limit = MCTS_DEFAULT_PLAYOUTS;
+        if (limit) limit = (limit + (uint64_t)threads - 1) / (uint64_t)threads;
+
+        PlayoutBoard start;
+        board_from_game(&start, game);
+
+        MctsJob jobs[MCTS_MAX_THREADS];
+        Thread workers[MCTS_MAX_THREADS];
+        int ready = 0;
+        for (int t = 0; t < threads; t++) {
+            MctsTree* tree = &g_trees[t];
+            if (!tree_reroot(tree, game) && !tree_reset(tree, game, t)) break;
+            jobs[ready].tree = tree;
+            jobs[ready].start = &start;
+            jobs[ready].deadline_ms = budget->deadline_ms;
+            jobs[ready].cancel = budget->cancel;
+            jobs[ready].limit = limit;
+            jobs[ready].playouts = 0;
+            ready++;
+        }
+
+        for (int t = 1; t < ready; t++) {
+            (void)thread_start(&workers[t], run_job, &jobs[t]);
+        }
+        if (ready > 0) run_job(&jobs[0]);
+
+        uint32_t visits[MAX_MOVES];
+        memset(visits, 0, sizeof(visits));
+        for (int t = 0; t < ready; t++) {
+            if (t > 0) thread_join(&workers[t]);
+            if (playouts) *playouts += jobs[t].playouts;
+
+            const MctsTree* tree = jobs[t].tree;
+            const MctsNode* root = &tree->nodes[tree->root];
+            if (root->first_child == MCTS_NO_NODE) continue;
+            for (uint32_t i = 0; i < root->child_count; i++) {
+                const MctsNode* child = &tree->nodes[root->first_child + i];
+                visits[child->cell] += child->visits;
+            }
+        }
+
+        uint32_t most = 0;
+        for (int i = 0; i < moves.count; i++) {
+            if (visits[moves.cells[i]] > most) {
+                most = visits[moves.cells[i]];
+                best = moves.cells[i];
+            }
+        }
+    }
+
+    move->row = (uint8_t)(best / n);
+    move->col = (uint8_t)(best % n);
+    return true;
+}
+
+void mcts_reset(void) {
+    for (int t = 0; t < MCTS_MAX_THREADS; t++) {
+        free(g_trees[t].nodes);
+        memset(&g_trees[t], 0, sizeof(g_trees[t]));
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "game.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Monte Carlo tree search for any board the game supports. Each thread
+ * grows its own UCT tree from the current position (root parallelism) and
+ * the root visit counts are summed to pick the move. Trees are kept
+ * between calls and re-rooted on the position actually reached, so work
+ * spent on the expected reply is not thrown away.
+ */
+#define MCTS_MAX_THREADS 64
+#define MCTS_DEFAULT_PLAYOUTS 20000
+
+typedef struct {
+    uint64_t deadline_ms;   /* absolute on monotime_ms(), 0 for none */
+    int playouts;           /* total over all threads, 0 for none */
+    int threads;
+    const volatile int* cancel;  /* stops the search early when set */
+} MctsBudget;
+
+bool mcts_best_move(const Game* game, const MctsBudget* budget, Move* move, uint64_t* playouts);
+void mcts_reset(void);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef MONOTIME_H
+#define MONOTIME_H
+
+#include <stdint.h>
+
+/* Milliseconds from an arbitrary fixed point; never goes backwards. */
+uint64_t monotime_ms(void);
+/* The same clock at the finest resolution the platform offers. */
+uint64_t monotime_ns(void);
+
+#endif
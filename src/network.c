@@ -1,4 +1,5 @@
 #include "network.h"
+#include "rng.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -363,13 +364,15 @@ static uint64_t derive_legacy_key_seed(const char* passphrase) {
 }
 
 static uint64_t generate_nonce64(const Network* net) {
-    uint64_t nonce = (uint64_t)(uintptr_t)net;
+    uint64_t nonce = 0;
+    if (random_bytes((uint8_t*)&nonce, sizeof(nonce))) {
+        return nonce;
+    }
+
+    nonce = (uint64_t)(uintptr_t)net;
     nonce ^= ((uint64_t)time(NULL) << 32);
     nonce ^= (uint64_t)clock();
-    nonce ^= ((uint64_t)(rand() & 0xffff) << 48);
-    nonce ^= ((uint64_t)(rand() & 0xffff) << 32);
-    nonce ^= ((uint64_t)(rand() & 0xffff) << 16);
-    nonce ^= (uint64_t)(rand() & 0xffff);
+    nonce ^= rng_entropy_seed();
     return mix64(nonce);
 }
 
@@ -1038,7 +1041,11 @@ bool network_sync_board(Network* net, Game* game) {
     NetworkPacket pkt;
     memset(&pkt, 0, sizeof(pkt));
     pkt.type = PACKET_SYNC;
-    memcpy(pkt.board, game->board, sizeof(game->board));
+    pkt.size = game->size;
+    pkt.win_length = game->win_length;
+    for (uint8_t r = 0; r < game->size; r++) {
+        memcpy(&pkt.cells[r * game->size], game->board[r], game->size);
+    }
     pkt.current_player = game->current_player;
 
     return send_packet(net, &pkt);
@@ -48,7 +48,9 @@ typedef struct {
     uint8_t type;
     uint8_t row;
     uint8_t col;
-    uint8_t board[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
+    uint8_t size;
+    uint8_t win_length;
+    uint8_t cells[MAX_MOVES];
     Player current_player;
     char message[BUFFER_SIZE];
 } NetworkPacket;
@@ -0,0 +1,134 @@
+#include "perfect.h"
+#include "symmetry.h"
+#include <string.h>
+
+#define PERFECT_SIZE 3
+#define PERFECT_CELLS (PERFECT_SIZE * PERFECT_SIZE)
+#define PERFECT_KEYS 19683
+#define PERFECT_WIN 10
+#define PERFECT_UNSOLVED 0x7F
+#define PERFECT_NO_MOVE 0xFF
+
+/* Score for the side to move (faster wins score higher) and the best move,
+ * both for the canonical orientation of the board. */
+typedef struct {
+    int8_t score;
+    uint8_t move;
+} PerfectEntry;
+
+static PerfectEntry g_entries[PERFECT_KEYS];
+static bool g_ready = false;
+
+static const uint8_t g_lines[8][3] = {
+    {0, 1, 2}, {3, 4, 5}, {6, 7, 8},
+    {0, 3, 6}, {1, 4, 7}, {2, 5, 8},
+    {0, 4, 8}, {2, 4, 6}
+};
+
+/* Base-3 key of the board under each symmetry; returns the smallest. */
+static uint16_t canonical_key(const uint8_t cells[PERFECT_CELLS], Symmetry* transform) {
+    uint16_t best = 0xFFFF;
+    for (int t = 0; t < SYMMETRY_COUNT; t++) {
+        const uint16_t* map = symmetry_cell_map(PERFECT_SIZE, (Symmetry)t);
+        uint8_t moved[PERFECT_CELLS];
+        for (int c = 0; c < PERFECT_CELLS; c++) {
+            moved[map[c]] = cells[c];
+        }
+
+        uint16_t key = 0;
+        for (int c = PERFECT_CELLS - 1; c >= 0; c--) {
+            key = (uint16_t)(key * 3 + moved[c]);
+        }
+        if (key < best) {
+            best = key;
+            if (transform) *transform = (Symmetry)t;
+        }
+    }
+    return best;
+}
+
+static bool completes_line(const uint8_t cells[PERFECT_CELLS], int cell, uint8_t side) {
+    for (int i = 0; i < 8; i++) {
+        const uint8_t* l = g_lines[i];
+        if (l[0] != cell && l[1] != cell && l[2] != cell) continue;
+        if (cells[l[0]] == side && cells[l[1]] == side && cells[l[2]] == side) return true;
+    }
+    return false;
+}
+
+static int solve(uint8_t cells[PERFECT_CELLS], uint8_t side, int filled) {
+    Symmetry transform = SYMMETRY_IDENTITY;
+    const uint16_t key = canonical_key(cells, &transform);
+    if (g_entries[key].score != PERFECT_UNSOLVED) return g_entries[key].score;
+
+    int best = -PERFECT_WIN - 1;
+    int best_cell = PERFECT_NO_MOVE;
+    for (int cell = 0; cell < PERFECT_CELLS; cell++) {
+        if (cells[cell] != PLAYER_NONE) continue;
+
+        cells[cell] = side;
+        int score;
+        if (completes_line(cells, cell, side)) {
+            score = PERFECT_WIN;
+        } else if (filled + 1 == PERFECT_CELLS) {
+            score = 0;
+        } else {
+            score = -solve(cells, (uint8_t)(3 - side), filled + 1);
+            if (score > 0) score--;
+            else if (score < 0) score++;
+        }
+        cells[cell] = PLAYER_NONE;
+
+        if (score > best) {
+            best = score;
+            best_cell = cell;
+        }
+    }
+
+    g_entries[key].score = (int8_t)best;
+    g_entries[key].move = (uint8_t)symmetry_apply(PERFECT_SIZE, transform, (uint16_t)best_cell);
+    return best;
+}
+
+void perfect_init(void) {
+    if (g_ready) return;
+
+    uint8_t cells[PERFECT_CELLS] = {0};
+    for (int i = 0; i < PERFECT_KEYS; i++) {
+        g_entries[i].score = PERFECT_UNSOLVED;
+        g_entries[i].move = PERFECT_NO_MOVE;
+    }
+    solve(cells, PLAYER_X, 0);
+    g_ready = true;
+}
+
+bool perfect_supports(const Game* game) {
+    return game && game->size == PERFECT_SIZE && game->win_length == PERFECT_SIZE;
+}
+
+bool perfect_best_move(const Game* game, Move* move, int* score) {
+    if (!perfect_supports(game) || !move) return false;
+
+    uint8_t cells[PERFECT_CELLS];
+    int stones[3] = {0, 0, 0};
+    for (int c = 0; c < PERFECT_CELLS; c++) {
+        cells[c] = game->board[c / PERFECT_SIZE][c % PERFECT_SIZE];
+        stones[cells[c]]++;
+    }
+
+    /* The table follows X-moves-first turn order; anything else is searched. */
+    const Player expected = (stones[PLAYER_X] == stones[PLAYER_O]) ? PLAYER_X : PLAYER_O;
+    if (game->current_player != expected) return false;
+
+    perfect_init();
+
+    Symmetry transform = SYMMETRY_IDENTITY;
+    const PerfectEntry* entry = &g_entries[canonical_key(cells, &transform)];
+    if (entry->score == PERFECT_UNSOLVED || entry->move == PERFECT_NO_MOVE) return false;
+
+    const uint16_t cell = symmetry_apply(PERFECT_SIZE, symmetry_inverse(transform), entry->move);
+    move->row = (uint8_t)(cell / PERFECT_SIZE);
+    move->col = (uint8_t)(cell % PERFECT_SIZE);
+    if (score) *score = entry->score;
+    return true;
+}
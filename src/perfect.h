@@ -0,0 +1,12 @@
+#ifndef PERFECT_H
+#define PERFECT_H
+
+#include "game.h"
+#include <stdbool.h>
+
+/* Solved 3x3 (three in a row): every reachable position, built on first use. */
+void perfect_init(void);
+bool perfect_supports(const Game* game);
+bool perfect_best_move(const Game* game, Move* move, int* score);
+
+#endif
@@ -0,0 +1,44 @@
+#include "position.h"
+#include "zobrist.h"
+#include <stddef.h>
+
+typedef char position_fits_16_bytes[(sizeof(Position) == 16) ? 1 : -1];
+
+bool position_from_game(Position* pos, const Game* game) {
+    if (!pos || !game || !bitboard_supports(game->size, game->win_length)) return false;
+
+    const uint8_t n = game->size;
+    Bitboard stones[2] = {0, 0};
+    for (uint8_t r = 0; r < n; r++) {
+        stones[0] |= (Bitboard)game->lines.rows[0][r] << (r * n);
+        stones[1] |= (Bitboard)game->lines.rows[1][r] << (r * n);
+    }
+
+    pos->hash = game->hash;
+    pos->bits[0] = stones[0] |
+                   ((uint32_t)n << POSITION_SIZE_SHIFT) |
+                   ((uint32_t)game->win_length << POSITION_WIN_SHIFT);
+    pos->bits[1] = stones[1] | ((uint32_t)(n * n - game->move_count) << POSITION_EMPTY_SHIFT);
+    if (game->current_player == PLAYER_O) {
+        pos->bits[0] |= POSITION_SIDE_FLAG;
+    }
+    return true;
+}
+
+void position_make(Position* pos, int cell) {
+    const Player side = position_side(pos);
+
+    pos->bits[side - 1] |= (Bitboard)1u << cell;
+    pos->bits[1] -= POSITION_EMPTY_ONE;
+    pos->bits[0] ^= POSITION_SIDE_FLAG;
+    pos->hash ^= zobrist_cell(side, cell) ^ zobrist_side();
+}
+
+void position_unmake(Position* pos, int cell) {
+    pos->bits[0] ^= POSITION_SIDE_FLAG;
+    const Player side = position_side(pos);
+
+    pos->bits[side - 1] &= ~((Bitboard)1u << cell);
+    pos->bits[1] += POSITION_EMPTY_ONE;
+    pos->hash ^= zobrist_cell(side, cell) ^ zobrist_side();
+}
@@ -0,0 +1,64 @@
+#ifndef POSITION_H
+#define POSITION_H
+
+#include "game.h"
+#include "bitboard.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Compact search state for boards up to BITBOARD_MAX_SIZE. Stones use the
+ * low 25 bits of each word; the spare high bits carry the rest:
+ *   bits[0] 25..27  board size
+ *   bits[0] 28..30  win length
+ *   bits[0] 31      side to move (set when O moves)
+ *   bits[1] 25..29  empty cell count
+ */
+typedef struct {
+    uint64_t hash;
+    uint32_t bits[2];
+} Position;
+
+#define POSITION_STONE_MASK 0x01FFFFFFu
+#define POSITION_SIZE_SHIFT 25
+#define POSITION_SIZE_MASK (0x7u << POSITION_SIZE_SHIFT)
+#define POSITION_WIN_SHIFT 28
+#define POSITION_WIN_MASK (0x7u << POSITION_WIN_SHIFT)
+#define POSITION_SIDE_FLAG 0x80000000u
+#define POSITION_EMPTY_SHIFT 25
+#define POSITION_EMPTY_ONE (1u << POSITION_EMPTY_SHIFT)
+
+static inline uint8_t position_size(const Position* pos) {
+    return (uint8_t)((pos->bits[0] & POSITION_SIZE_MASK) >> POSITION_SIZE_SHIFT);
+}
+
+static inline uint8_t position_win_length(const Position* pos) {
+    return (uint8_t)((pos->bits[0] & POSITION_WIN_MASK) >> POSITION_WIN_SHIFT);
+}
+
+static inline Player position_side(const Position* pos) {
+    return (pos->bits[0] & POSITION_SIDE_FLAG) ? PLAYER_O : PLAYER_X;
+}
+
+static inline int position_empty_count(const Position* pos) {
+    return (int)(pos->bits[1] >> POSITION_EMPTY_SHIFT);
+}
+
+static inline Bitboard position_stones(const Position* pos, Player player) {
+    return pos->bits[player - 1] & POSITION_STONE_MASK;
+}
+
+static inline Bitboard position_empty(const Position* pos) {
+    return ~(pos->bits[0] | pos->bits[1]) & bitboard_full_mask(position_size(pos));
+}
+
+/* Whether the side that just moved has completed a line. */
+static inline bool position_mover_wins(const Position* pos, BitboardWinKernel has_win) {
+    return has_win(position_stones(pos, (position_side(pos) == PLAYER_X) ? PLAYER_O : PLAYER_X));
+}
+
+bool position_from_game(Position* pos, const Game* game);
+void position_make(Position* pos, int cell);
+void position_unmake(Position* pos, int cell);
+
+#endif
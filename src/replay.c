@@ -7,6 +7,7 @@ void replay_init(Replay* replay) {
     if (!replay) return;
     memset(replay, 0, sizeof(Replay));
     replay->size = MIN_BOARD_SIZE;
+    replay->win_length = game_default_win_length(MIN_BOARD_SIZE);
     replay->current_player = PLAYER_X;
     replay->mode = MODE_LOCAL_2P;
     replay->game_time = time(NULL);
@@ -18,7 +19,9 @@ void replay_start(Replay* replay, Game* game) {
     
     memset(replay, 0, sizeof(Replay));
     replay->size = game->size;
+    replay->win_length = game->win_length;
     replay->mode = game->mode;
+    replay->seed = game->seed;
     replay->winner = PLAYER_NONE;
     replay->game_time = time(NULL);
     replay->current_step = -1;
@@ -44,7 +47,9 @@ bool replay_save(Replay* replay, const char* filepath) {
     
     fprintf(f, "# TicTacToe-CX Replay\n");
     fprintf(f, "size %d\n", replay->size);
+    fprintf(f, "win %d\n", replay->win_length);
     fprintf(f, "mode %d\n", replay->mode);
+    fprintf(f, "seed %llu\n", (unsigned long long)replay->seed);
     fprintf(f, "moves %d\n", replay->move_count);
     fprintf(f, "# Moves (row col player)\n");
     
@@ -76,12 +81,21 @@ bool replay_load(Replay* replay, const char* filepath) {
             int size = 0;
             if (sscanf(line + 5, "%d", &size) == 1 && size >= MIN_BOARD_SIZE && size <= MAX_BOARD_SIZE) {
                 replay->size = (uint8_t)size;
+                replay->win_length = game_default_win_length(replay->size);
+            }
+        } else if (strncmp(line, "win ", 4) == 0) {
+            int length = 0;
+            if (sscanf(line + 4, "%d", &length) == 1 && length >= MIN_WIN_LENGTH && length <= replay->size) {
+                replay->win_length = (uint8_t)length;
             }
         } else if (strncmp(line, "mode ", 5) == 0) {
             int mode = 0;
-            if (sscanf(line + 5, "%d", &mode) == 1 && mode >= MODE_LOCAL_2P && mode <= MODE_NETWORK_CLIENT) {
+            if (sscanf(line + 5, "%d", &mode) == 1 && mode >= MODE_LOCAL_2P && mode <= MODE_AI_MCTS) {
                 replay->mode = (GameMode)mode;
             }
+        } else if (strncmp(line, "seed ", 5) == 0) {
+            unsigned long long seed = 0;
+            if (sscanf(line + 5, "%llu", &seed) == 1) replay->seed = (uint64_t)seed;
         } else {
             int r, c, p;
             if (sscanf(line, "%d %d %d", &r, &c, &p) == 3) {
@@ -146,7 +160,7 @@ void replay_history_init(ReplayHistory* history) {
 
 bool replay_history_add(ReplayHistory* history, Replay* replay) {
     if (!history || !replay) return false;
-    if (history->count >= MAX_REPLAY_MOVES) return false;
+    if (history->count >= MAX_REPLAY_HISTORY) return false;
     
     history->replays[history->count] = *replay;
     history->count++;
@@ -178,7 +192,9 @@ bool replay_history_save(ReplayHistory* history, const char* filepath) {
         Replay* r = &history->replays[i];
         fprintf(f, "\n# Replay %d\n", i + 1);
         fprintf(f, "size %d\n", r->size);
+        fprintf(f, "win %d\n", r->win_length);
         fprintf(f, "mode %d\n", r->mode);
+        fprintf(f, "seed %llu\n", (unsigned long long)r->seed);
         fprintf(f, "moves %d\n", r->move_count);
         
         for (int j = 0; j < r->move_count; j++) {
@@ -221,7 +237,7 @@ bool replay_history_load(ReplayHistory* history, const char* filepath) {
         }
 
         if (strncmp(line, "# Replay ", 9) == 0) {
-            if (history->count >= MAX_REPLAY_MOVES) {
+            if (history->count >= MAX_REPLAY_HISTORY) {
                 current = NULL;
                 continue;
             }
@@ -244,13 +260,23 @@ bool replay_history_load(ReplayHistory* history, const char* filepath) {
             if (sscanf(line + 5, "%d", &size) == 1 &&
                 size >= MIN_BOARD_SIZE && size <= MAX_BOARD_SIZE) {
                 current->size = (uint8_t)size;
+                current->win_length = game_default_win_length(current->size);
+            }
+        } else if (strncmp(line, "win ", 4) == 0) {
+            int length = 0;
+            if (sscanf(line + 4, "%d", &length) == 1 &&
+                length >= MIN_WIN_LENGTH && length <= current->size) {
+                current->win_length = (uint8_t)length;
             }
         } else if (strncmp(line, "mode ", 5) == 0) {
             int mode = 0;
             if (sscanf(line + 5, "%d", &mode) == 1 &&
-                mode >= MODE_LOCAL_2P && mode <= MODE_NETWORK_CLIENT) {
+                mode >= MODE_LOCAL_2P && mode <= MODE_AI_MCTS) {
                 current->mode = (GameMode)mode;
             }
+        } else if (strncmp(line, "seed ", 5) == 0) {
+            unsigned long long seed = 0;
+            if (sscanf(line + 5, "%llu", &seed) == 1) current->seed = (uint64_t)seed;
         } else if (strncmp(line, "moves ", 6) == 0) {
             continue;
         } else {
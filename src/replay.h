@@ -5,14 +5,17 @@
 #include <stdbool.h>
 #include <time.h>
 
-#define MAX_REPLAY_MOVES 100
+#define MAX_REPLAY_MOVES MAX_MOVES
+#define MAX_REPLAY_HISTORY 100
 
 typedef struct {
     uint8_t board[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
     uint8_t size;
+    uint8_t win_length;
     Player current_player;
     Player winner;
     GameMode mode;
+    uint64_t seed;              /* the game's AI seed, 0 if not recorded */
     int move_count;
     Move moves[MAX_REPLAY_MOVES];
     time_t game_time;
@@ -20,7 +23,7 @@ typedef struct {
 } Replay;
 
 typedef struct {
-    Replay replays[MAX_REPLAY_MOVES];
+    Replay replays[MAX_REPLAY_HISTORY];
     int count;
     int current_index;
 } ReplayHistory;
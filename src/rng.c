@@ -0,0 +1,31 @@
+#include "rng.h"
+#include "monotime.h"
+#include <time.h>
+
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void rng_seed(Rng* rng, uint64_t seed) {
+    if (!rng) return;
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&seed);
+    }
+}
+
+/* No shared state, so any thread may call it. Each call waits for a clock
+ * tick of its own, which keeps calls on one thread apart; the address of a
+ * local keeps threads apart, as each has its own stack. */
+uint64_t rng_entropy_seed(void) {
+    const uint64_t entered = monotime_ns();
+    uint64_t now = entered;
+    while (now == entered) {
+        now = monotime_ns();
+    }
+    uint64_t state = ((uint64_t)time(NULL) << 32) ^ now;
+    state ^= (uint64_t)(uintptr_t)&now * 0xD1B54A32D192ED03ULL;
+    return splitmix64(&state);
+}
@@ -0,0 +1,42 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/*
+ * xoshiro256** with splitmix64 seeding. Each user keeps its own state, so
+ * threads never contend on it and a seed replays the same sequence.
+ */
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+void rng_seed(Rng* rng, uint64_t seed);
+/* A seed that differs from call to call, for callers without one. Safe to
+ * call from any thread. */
+uint64_t rng_entropy_seed(void);
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t rng_next(Rng* rng) {
+    uint64_t* s = rng->s;
+    const uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+/* Uniform in [0, bound) by multiply-shift; the bias is negligible for board-sized bounds. */
+static inline uint32_t rng_below(Rng* rng, uint32_t bound) {
+    return (uint32_t)(((rng_next(rng) >> 32) * bound) >> 32);
+}
+
+#endif
@@ -0,0 +1,58 @@
+#include "symmetry.h"
+#include <stddef.h>
+
+#define SYMMETRY_SIZE_COUNT (MAX_BOARD_SIZE - MIN_BOARD_SIZE + 1)
+
+/* g_maps[size - 3][t][cell] is the cell that `cell` lands on under transform t. */
+static uint16_t g_maps[SYMMETRY_SIZE_COUNT][SYMMETRY_COUNT][MAX_MOVES];
+static bool g_maps_ready = false;
+
+static void transform_coords(int n, Symmetry t, int r, int c, int* out_r, int* out_c) {
+    switch (t) {
+        case SYMMETRY_ROT90:          *out_r = c;         *out_c = n - 1 - r; break;
+        case SYMMETRY_ROT180:         *out_r = n - 1 - r; *out_c = n - 1 - c; break;
+        case SYMMETRY_ROT270:         *out_r = n - 1 - c; *out_c = r;         break;
+        case SYMMETRY_FLIP_COLS:      *out_r = r;         *out_c = n - 1 - c; break;
+        case SYMMETRY_FLIP_ROWS:      *out_r = n - 1 - r; *out_c = c;         break;
+        case SYMMETRY_TRANSPOSE:      *out_r = c;         *out_c = r;         break;
+        case SYMMETRY_ANTI_TRANSPOSE: *out_r = n - 1 - c; *out_c = n - 1 - r; break;
+        default:                      *out_r = r;         *out_c = c;         break;
+    }
+}
+
+void symmetry_init(void) {
+    if (g_maps_ready) return;
+
+    for (int n = MIN_BOARD_SIZE; n <= MAX_BOARD_SIZE; n++) {
+        for (int t = 0; t < SYMMETRY_COUNT; t++) {
+            uint16_t* map = g_maps[n - MIN_BOARD_SIZE][t];
+            for (int r = 0; r < n; r++) {
+                for (int c = 0; c < n; c++) {
+                    int tr, tc;
+                    transform_coords(n, (Symmetry)t, r, c, &tr, &tc);
+                    map[r * n + c] = (uint16_t)(tr * n + tc);
+                }
+            }
+        }
+    }
+    g_maps_ready = true;
+}
+
+const uint16_t* symmetry_cell_map(uint8_t size, Symmetry transform) {
+    if (size < MIN_BOARD_SIZE || size > MAX_BOARD_SIZE) return NULL;
+    if (transform < 0 || transform >= SYMMETRY_COUNT) return NULL;
+    symmetry_init();
+    return g_maps[size - MIN_BOARD_SIZE][transform];
+}
+
+Symmetry symmetry_inverse(Symmetry transform) {
+    if (transform == SYMMETRY_ROT90) return SYMMETRY_ROT270;
+    if (transform == SYMMETRY_ROT270) return SYMMETRY_ROT90;
+    return transform;
+}
+
+uint16_t symmetry_apply(uint8_t size, Symmetry transform, uint16_t cell) {
+    const uint16_t* map = symmetry_cell_map(size, transform);
+    if (!map || cell >= size * size) return cell;
+    return map[cell];
+}
@@ -0,0 +1,25 @@
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include "game.h"
+#include <stdint.h>
+
+/* The eight rotations and reflections of a square board (dihedral group D4). */
+typedef enum {
+    SYMMETRY_IDENTITY,
+    SYMMETRY_ROT90,
+    SYMMETRY_ROT180,
+    SYMMETRY_ROT270,
+    SYMMETRY_FLIP_COLS,
+    SYMMETRY_FLIP_ROWS,
+    SYMMETRY_TRANSPOSE,
+    SYMMETRY_ANTI_TRANSPOSE,
+    SYMMETRY_COUNT
+} Symmetry;
+
+void symmetry_init(void);
+const uint16_t* symmetry_cell_map(uint8_t size, Symmetry transform);
+Symmetry symmetry_inverse(Symmetry transform);
+uint16_t symmetry_apply(uint8_t size, Symmetry transform, uint16_t cell);
+
+#endif
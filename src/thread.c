@@ -0,0 +1,57 @@
+#include "thread.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+#ifdef _WIN32
+static DWORD WINAPI thread_entry(LPVOID param) {
+    Thread* thread = (Thread*)param;
+    thread->func(thread->arg);
+    return 0;
+}
+#else
+static void* thread_entry(void* param) {
+    Thread* thread = (Thread*)param;
+    thread->func(thread->arg);
+    return NULL;
+}
+#endif
+
+bool thread_start(Thread* thread, ThreadFunc func, void* arg) {
+    if (!thread || !func) return false;
+
+    thread->func = func;
+    thread->arg = arg;
+#ifdef _WIN32
+    thread->handle = CreateThread(NULL, 0, thread_entry, thread, 0, NULL);
+    thread->started = thread->handle != NULL;
+#else
+    thread->started = pthread_create(&thread->handle, NULL, thread_entry, thread) == 0;
+#endif
+    return thread->started;
+}
+
+void thread_join(Thread* thread) {
+    if (!thread || !thread->started) return;
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)thread->handle, INFINITE);
+    CloseHandle((HANDLE)thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+    thread->started = false;
+}
+
+int thread_cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? (int)info.dwNumberOfProcessors : 1;
+#else
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (int)count : 1;
+#endif
+}
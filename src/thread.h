@@ -0,0 +1,27 @@
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <stdbool.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+typedef void (*ThreadFunc)(void* arg);
+
+typedef struct {
+#ifdef _WIN32
+    void* handle;
+#else
+    pthread_t handle;
+#endif
+    ThreadFunc func;
+    void* arg;
+    bool started;
+} Thread;
+
+bool thread_start(Thread* thread, ThreadFunc func, void* arg);
+void thread_join(Thread* thread);
+int thread_cpu_count(void);
+
+#endif
@@ -0,0 +1,121 @@
+#include "ttable.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TTABLE_CACHE_LINE 64
+
+/* data: score 0..15, depth 16..23, bound 24..25, move 32..47, age 48..55. */
+#define TTABLE_SCORE(d) ((int16_t)(uint16_t)((d) & 0xFFFFu))
+#define TTABLE_DEPTH(d) ((uint8_t)(((d) >> 16) & 0xFFu))
+#define TTABLE_BOUND(d) ((uint8_t)(((d) >> 24) & 0x3u))
+#define TTABLE_MOVE(d) ((uint16_t)(((d) >> 32) & 0xFFFFu))
+#define TTABLE_AGE(d) ((uint8_t)(((d) >> 48) & 0xFFu))
+
+typedef char ttable_bucket_is_cache_line[(sizeof(TTableBucket) == TTABLE_CACHE_LINE) ? 1 : -1];
+
+static uint64_t pack_data(int depth, TTableBound bound, int score, uint16_t move, uint8_t age) {
+    return (uint64_t)(uint16_t)(int16_t)score |
+           ((uint64_t)(uint8_t)depth << 16) |
+           ((uint64_t)bound << 24) |
+           ((uint64_t)move << 32) |
+           ((uint64_t)age << 48);
+}
+
+bool ttable_init(TransTable* table, size_t megabytes) {
+    if (!table) return false;
+    memset(table, 0, sizeof(*table));
+    if (megabytes == 0) return true;
+
+    const size_t budget = megabytes * 1024u * 1024u;
+    size_t count = 1;
+    while (count * 2 * sizeof(TTableBucket) <= budget) {
+        count *= 2;
+    }
+
+    void* raw = malloc(count * sizeof(TTableBucket) + TTABLE_CACHE_LINE - 1);
+    if (!raw) return false;
+
+    const uintptr_t aligned = ((uintptr_t)raw + TTABLE_CACHE_LINE - 1) & ~(uintptr_t)(TTABLE_CACHE_LINE - 1);
+    table->allocation = raw;
+    table->buckets = (TTableBucket*)aligned;
+    table->bucket_mask = count - 1;
+    ttable_clear(table);
+    return true;
+}
+
+void ttable_free(TransTable* table) {
+    if (!table) return;
+    free(table->allocation);
+    memset(table, 0, sizeof(*table));
+}
+
+void ttable_clear(TransTable* table) {
+    if (!table || !table->buckets) return;
+    memset(table->buckets, 0, (table->bucket_mask + 1) * sizeof(TTableBucket));
+    table->age = 0;
+}
+
+void ttable_new_search(TransTable* table) {
+    if (!table) return;
+    table->age++;
+}
+
+bool ttable_probe(const TransTable* table, uint64_t hash, TTableHit* hit) {
+    if (!table || !table->buckets || !hit) return false;
+
+    const volatile TTableEntry* entries = table->buckets[hash & table->bucket_mask].entries;
+    for (int i = 0; i < TTABLE_BUCKET_ENTRIES; i++) {
+        const uint64_t data = entries[i].data;
+        if ((entries[i].key ^ data) != hash || TTABLE_BOUND(data) == TTABLE_BOUND_NONE) continue;
+
+        hit->score = TTABLE_SCORE(data);
+        hit->depth = TTABLE_DEPTH(data);
+        hit->bound = TTABLE_BOUND(data);
+        hit->move = TTABLE_MOVE(data);
+        return true;
+    }
+    return false;
+}
+
+/* Lower is a better victim: shallow entries from earlier searches go first. */
+static int replacement_worth(const TransTable* table, uint64_t data) {
+    const uint8_t stale = (uint8_t)(table->age - TTABLE_AGE(data));
+    return (int)TTABLE_DEPTH(data) - 8 * (int)stale;
+}
+
+void ttable_store(TransTable* table, uint64_t hash, int depth, TTableBound bound, int score, uint16_t move) {
+    if (!table || !table->buckets) return;
+
+    volatile TTableEntry* entries = table->buckets[hash & table->bucket_mask].entries;
+    volatile TTableEntry* victim = NULL;
+    int victim_worth = 0;
+
+    for (int i = 0; i < TTABLE_BUCKET_ENTRIES; i++) {
+        volatile TTableEntry* entry = &entries[i];
+        const uint64_t data = entry->data;
+
+        if ((entry->key ^ data) == hash) {
+            if (TTABLE_AGE(data) == table->age && depth < TTABLE_DEPTH(data) &&
+                bound != TTABLE_BOUND_EXACT) {
+                return;
+            }
+            if (move == TTABLE_NO_MOVE) move = TTABLE_MOVE(data);
+            victim = entry;
+            break;
+        }
+        if (TTABLE_BOUND(data) == TTABLE_BOUND_NONE) {
+            victim = entry;
+            break;
+        }
+
+        const int worth = replacement_worth(table, data);
+        if (!victim || worth < victim_worth) {
+            victim = entry;
+            victim_worth = worth;
+        }
+    }
+
+    const uint64_t data = pack_data(depth, bound, score, move, table->age);
+    victim->data = data;
+    victim->key = hash ^ data;
+}
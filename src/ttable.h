@@ -0,0 +1,52 @@
+#ifndef TTABLE_H
+#define TTABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TTABLE_BUCKET_ENTRIES 4
+#define TTABLE_NO_MOVE 0xFFFF
+
+typedef enum {
+    TTABLE_BOUND_NONE,
+    TTABLE_BOUND_EXACT,
+    TTABLE_BOUND_LOWER,
+    TTABLE_BOUND_UPPER
+} TTableBound;
+
+/* `key` holds the position hash xor `data`, so a torn write never
+ * validates against the wrong position. That is what lets search threads
+ * share one table without locks: each field is read exactly once. */
+typedef struct {
+    uint64_t key;
+    uint64_t data;
+} TTableEntry;
+
+/* One bucket per 64-byte cache line. */
+typedef struct {
+    TTableEntry entries[TTABLE_BUCKET_ENTRIES];
+} TTableBucket;
+
+typedef struct {
+    int16_t score;
+    uint8_t depth;
+    uint8_t bound;
+    uint16_t move;
+} TTableHit;
+
+typedef struct {
+    TTableBucket* buckets;
+    void* allocation;
+    size_t bucket_mask;
+    uint8_t age;
+} TransTable;
+
+bool ttable_init(TransTable* table, size_t megabytes);
+void ttable_free(TransTable* table);
+void ttable_clear(TransTable* table);
+void ttable_new_search(TransTable* table);
+bool ttable_probe(const TransTable* table, uint64_t hash, TTableHit* hit);
+void ttable_store(TransTable* table, uint64_t hash, int depth, TTableBound bound, int score, uint16_t move);
+
+#endif
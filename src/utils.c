@@ -33,6 +33,8 @@
 static char g_data_root_path[PATH_MAX] = {0};
 static char g_config_path[PATH_MAX] = {0};
 static char g_highscore_path[PATH_MAX] = {0};
+static char g_enddb_path[PATH_MAX] = {0};
+static char g_book_path[PATH_MAX] = {0};
 static bool g_paths_initialized = false;
 
 static bool safe_vsnprintf(char* out, size_t out_size, const char* fmt, va_list args) {
@@ -325,6 +327,12 @@ static bool set_data_paths_from_root(const char* root) {
                        root, PATH_SEP_CHAR, PATH_SEP_CHAR)) {
         return false;
     }
+    if (!safe_snprintf(g_enddb_path, sizeof(g_enddb_path), "%s%cenddb_4x4.bin", root, PATH_SEP_CHAR)) {
+        return false;
+    }
+    if (!safe_snprintf(g_book_path, sizeof(g_book_path), "%s%copening_book.bin", root, PATH_SEP_CHAR)) {
+        return false;
+    }
     return true;
 }
 
@@ -479,7 +487,15 @@ bool init_data_paths(bool interactive_prompt) {
 void config_init(Config* cfg) {
     if (!cfg) return;
     cfg->board_size = 3;
+    cfg->win_length = 0;
     cfg->ai_difficulty = 2;
+    cfg->ai_hash_mb = 16;
+    cfg->ai_time_ms = 1000;
+    cfg->ai_threads = 1;
+    cfg->ai_playouts = 20000;
+    cfg->ai_ponder = false;
+    cfg->ai_solver_mb = 8;
+    cfg->ai_seed = 0;
     cfg->timer_seconds = 0;
     cfg->timer_enabled = false;
     cfg->player_symbol = 'X';
@@ -503,8 +519,24 @@ bool config_load(Config* cfg, const char* filepath) {
         if (sscanf(line, "%63[^=]=%63s", key, value) == 2) {
             if (strcmp(key, "board_size") == 0) {
                 cfg->board_size = atoi(value);
+            } else if (strcmp(key, "win_length") == 0) {
+                cfg->win_length = atoi(value);
             } else if (strcmp(key, "ai_difficulty") == 0) {
                 cfg->ai_difficulty = atoi(value);
+            } else if (strcmp(key, "ai_hash_mb") == 0) {
+                cfg->ai_hash_mb = atoi(value);
+            } else if (strcmp(key, "ai_time_ms") == 0) {
+                cfg->ai_time_ms = atoi(value);
+            } else if (strcmp(key, "ai_threads") == 0) {
+                cfg->ai_threads = atoi(value);
+            } else if (strcmp(key, "ai_playouts") == 0) {
+                cfg->ai_playouts = atoi(value);
+            } else if (strcmp(key, "ai_ponder") == 0) {
+                cfg->ai_ponder = (strcmp(value, "true") == 0 || strcmp(value, "1") == 0);
+            } else if (strcmp(key, "ai_solver_mb") == 0) {
+                cfg->ai_solver_mb = atoi(value);
+            } else if (strcmp(key, "ai_seed") == 0) {
+                cfg->ai_seed = strtoull(value, NULL, 10);
             } else if (strcmp(key, "timer_seconds") == 0) {
                 cfg->timer_seconds = atoi(value);
             } else if (strcmp(key, "timer_enabled") == 0) {
@@ -520,7 +552,15 @@ bool config_load(Config* cfg, const char* filepath) {
     }
 
     cfg->board_size = clamp_int(cfg->board_size, MIN_BOARD_SIZE, MAX_BOARD_SIZE);
+    if (cfg->win_length != 0) {
+        cfg->win_length = clamp_int(cfg->win_length, MIN_WIN_LENGTH, cfg->board_size);
+    }
     cfg->ai_difficulty = clamp_int(cfg->ai_difficulty, 1, 3);
+    cfg->ai_hash_mb = clamp_int(cfg->ai_hash_mb, 0, 1024);
+    cfg->ai_time_ms = clamp_int(cfg->ai_time_ms, 0, 60000);
+    cfg->ai_threads = clamp_int(cfg->ai_threads, 1, 64);
+    cfg->ai_playouts = clamp_int(cfg->ai_playouts, 0, 10000000);
+    cfg->ai_solver_mb = clamp_int(cfg->ai_solver_mb, 0, 1024);
     cfg->timer_seconds = (cfg->timer_seconds < 0) ? 0 : cfg->timer_seconds;
     if (cfg->player_symbol != 'X' && cfg->player_symbol != 'O') {
         cfg->player_symbol = 'X';
@@ -539,7 +579,15 @@ bool config_save(Config* cfg, const char* filepath) {
     if (!f) return false;
 
     fprintf(f, "board_size=%d\n", cfg->board_size);
+    fprintf(f, "win_length=%d\n", cfg->win_length);
     fprintf(f, "ai_difficulty=%d\n", cfg->ai_difficulty);
+    fprintf(f, "ai_hash_mb=%d\n", cfg->ai_hash_mb);
+    fprintf(f, "ai_time_ms=%d\n", cfg->ai_time_ms);
+    fprintf(f, "ai_threads=%d\n", cfg->ai_threads);
+    fprintf(f, "ai_playouts=%d\n", cfg->ai_playouts);
+    fprintf(f, "ai_ponder=%s\n", cfg->ai_ponder ? "true" : "false");
+    fprintf(f, "ai_solver_mb=%d\n", cfg->ai_solver_mb);
+    fprintf(f, "ai_seed=%llu\n", (unsigned long long)cfg->ai_seed);
     fprintf(f, "timer_seconds=%d\n", cfg->timer_seconds);
     fprintf(f, "timer_enabled=%s\n", cfg->timer_enabled ? "true" : "false");
     fprintf(f, "player_symbol=%c\n", cfg->player_symbol);
@@ -624,3 +672,17 @@ const char* get_highscore_path(void) {
     }
     return (g_highscore_path[0] != '\0') ? g_highscore_path : "saves/highscores.txt";
 }
+
+const char* get_endgame_db_path(void) {
+    if (!g_paths_initialized) {
+        (void)init_data_paths(false);
+    }
+    return (g_enddb_path[0] != '\0') ? g_enddb_path : "enddb_4x4.bin";
+}
+
+const char* get_opening_book_path(void) {
+    if (!g_paths_initialized) {
+        (void)init_data_paths(false);
+    }
+    return (g_book_path[0] != '\0') ? g_book_path : "opening_book.bin";
+}
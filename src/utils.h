@@ -6,7 +6,15 @@
 
 typedef struct {
     int board_size;
+    int win_length;
     int ai_difficulty;
+    int ai_hash_mb;
+    int ai_time_ms;
+    int ai_threads;
+    int ai_playouts;
+    bool ai_ponder;
+    int ai_solver_mb;
+    uint64_t ai_seed;
     int timer_seconds;
     bool timer_enabled;
     char player_symbol;
@@ -33,5 +41,7 @@ bool init_data_paths(bool interactive_prompt);
 const char* get_data_root_path(void);
 const char* get_config_path(void);
 const char* get_highscore_path(void);
+const char* get_endgame_db_path(void);
+const char* get_opening_book_path(void);
 
 #endif
@@ -0,0 +1,181 @@
+#include "winbatch.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || \
+    ((defined(__i386__) || defined(_M_IX86)) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define WINBATCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define WINBATCH_TARGET_AVX2
+#else
+#define WINBATCH_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#define WINBATCH_RULES_MASK (POSITION_SIZE_MASK | POSITION_WIN_MASK)
+
+typedef char winbatch_player_is_32_bits[(sizeof(Player) == sizeof(int32_t)) ? 1 : -1];
+
+static Player winner_scalar(const Position* pos) {
+    const BitboardWinKernel has_win = bitboard_win_kernel(position_size(pos), position_win_length(pos));
+    if (!has_win) return PLAYER_NONE;
+    if (has_win(position_stones(pos, PLAYER_X))) return PLAYER_X;
+    if (has_win(position_stones(pos, PLAYER_O))) return PLAYER_O;
+    return PLAYER_NONE;
+}
+
+static void batch_scalar(const Position* positions, size_t count, Player* out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = winner_scalar(&positions[i]);
+    }
+}
+
+#ifdef WINBATCH_X86
+
+/* Non-zero lanes hold a run start for that lane's stones. */
+static __m128i runs_sse2(__m128i stones, const Bitboard* starts, int n, int k) {
+    const int shifts[4] = {1, n, n + 1, n - 1};
+    __m128i found = _mm_setzero_si128();
+
+    for (int d = 0; d < 4; d++) {
+        __m128i runs = _mm_and_si128(stones, _mm_set1_epi32((int)starts[d]));
+        for (int i = 1; i < k; i++) {
+            runs = _mm_and_si128(runs, _mm_srl_epi32(stones, _mm_cvtsi32_si128(i * shifts[d])));
+        }
+        found = _mm_or_si128(found, runs);
+    }
+    return found;
+}
+
+static void batch_sse2(const Position* positions, size_t count, Player* out) {
+    const __m128i stone_mask = _mm_set1_epi32((int)POSITION_STONE_MASK);
+    const __m128i rules_mask = _mm_set1_epi32((int)WINBATCH_RULES_MASK);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        const Position* p = &positions[i];
+        const uint32_t rules = p[0].bits[0] & WINBATCH_RULES_MASK;
+        const Bitboard* starts = bitboard_run_starts((uint8_t)(rules >> POSITION_SIZE_SHIFT & 0x7u),
+                                                     (uint8_t)(rules >> POSITION_WIN_SHIFT & 0x7u));
+
+        /* Each load is {hash lo, hash hi, bits[0], bits[1]}; gather the
+         * stone words of four positions into one register per side. */
+        const __m128i hi01 = _mm_unpackhi_epi32(_mm_loadu_si128((const __m128i*)&p[0]),
+                                                _mm_loadu_si128((const __m128i*)&p[1]));
+        const __m128i hi23 = _mm_unpackhi_epi32(_mm_loadu_si128((const __m128i*)&p[2]),
+                                                _mm_loadu_si128((const __m128i*)&p[3]));
+        const __m128i raw_x = _mm_unpacklo_epi64(hi01, hi23);
+        const __m128i raw_o = _mm_unpackhi_epi64(hi01, hi23);
+
+        const __m128i same = _mm_cmpeq_epi32(_mm_and_si128(raw_x, rules_mask), _mm_set1_epi32((int)rules));
+        /* Mixed batches gain nothing from the lanes; finish them scalar
+         * rather than testing every group. */
+        if (!starts || _mm_movemask_ps(_mm_castsi128_ps(same)) != 0xF) {
+            batch_scalar(p, count - i, &out[i]);
+            return;
+        }
+
+        const int n = (int)position_size(&p[0]);
+        const int k = (int)position_win_length(&p[0]);
+        const __m128i x_runs = runs_sse2(_mm_and_si128(raw_x, stone_mask), starts, n, k);
+        const __m128i o_runs = runs_sse2(_mm_and_si128(raw_o, stone_mask), starts, n, k);
+        const __m128i x_none = _mm_cmpeq_epi32(x_runs, zero);
+        const __m128i o_none = _mm_cmpeq_epi32(o_runs, zero);
+        const __m128i winner = _mm_or_si128(_mm_andnot_si128(x_none, _mm_set1_epi32(PLAYER_X)),
+                                            _mm_and_si128(x_none, _mm_andnot_si128(o_none, _mm_set1_epi32(PLAYER_O))));
+        _mm_storeu_si128((__m128i*)&out[i], winner);
+    }
+    batch_scalar(&positions[i], count - i, &out[i]);
+}
+
+WINBATCH_TARGET_AVX2
+static __m256i runs_avx2(__m256i stones, const Bitboard* starts, int n, int k) {
+    const int shifts[4] = {1, n, n + 1, n - 1};
+    __m256i found = _mm256_setzero_si256();
+
+    for (int d = 0; d < 4; d++) {
+        __m256i runs = _mm256_and_si256(stones, _mm256_set1_epi32((int)starts[d]));
+        for (int i = 1; i < k; i++) {
+            runs = _mm256_and_si256(runs, _mm256_srl_epi32(stones, _mm_cvtsi32_si128(i * shifts[d])));
+        }
+        found = _mm256_or_si256(found, runs);
+    }
+    return found;
+}
+
+WINBATCH_TARGET_AVX2
+static void batch_avx2(const Position* positions, size_t count, Player* out) {
+    /* The in-lane unpacks leave positions 0,2,4,6,1,3,5,7 in lanes 0..7. */
+    const __m256i lane_order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    const __m256i stone_mask = _mm256_set1_epi32((int)POSITION_STONE_MASK);
+    const __m256i rules_mask = _mm256_set1_epi32((int)WINBATCH_RULES_MASK);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const Position* p = &positions[i];
+        const uint32_t rules = p[0].bits[0] & WINBATCH_RULES_MASK;
+        const Bitboard* starts = bitboard_run_starts((uint8_t)(rules >> POSITION_SIZE_SHIFT & 0x7u),
+                                                     (uint8_t)(rules >> POSITION_WIN_SHIFT & 0x7u));
+
+        const __m256i hi_a = _mm256_unpackhi_epi32(_mm256_loadu_si256((const __m256i*)&p[0]),
+                                                   _mm256_loadu_si256((const __m256i*)&p[2]));
+        const __m256i hi_b = _mm256_unpackhi_epi32(_mm256_loadu_si256((const __m256i*)&p[4]),
+                                                   _mm256_loadu_si256((const __m256i*)&p[6]));
+        const __m256i raw_x = _mm256_unpacklo_epi64(hi_a, hi_b);
+        const __m256i raw_o = _mm256_unpackhi_epi64(hi_a, hi_b);
+
+        const __m256i same = _mm256_cmpeq_epi32(_mm256_and_si256(raw_x, rules_mask), _mm256_set1_epi32((int)rules));
+        if (!starts || _mm256_movemask_ps(_mm256_castsi256_ps(same)) != 0xFF) {
+            batch_scalar(p, count - i, &out[i]);
+            return;
+        }
+
+        const int n = (int)position_size(&p[0]);
+        const int k = (int)position_win_length(&p[0]);
+        const __m256i x_runs = runs_avx2(_mm256_and_si256(raw_x, stone_mask), starts, n, k);
+        const __m256i o_runs = runs_avx2(_mm256_and_si256(raw_o, stone_mask), starts, n, k);
+        const __m256i x_none = _mm256_cmpeq_epi32(x_runs, zero);
+        const __m256i o_none = _mm256_cmpeq_epi32(o_runs, zero);
+        const __m256i winner = _mm256_or_si256(
+            _mm256_andnot_si256(x_none, _mm256_set1_epi32(PLAYER_X)),
+            _mm256_and_si256(x_none, _mm256_andnot_si256(o_none, _mm256_set1_epi32(PLAYER_O))));
+        _mm256_storeu_si256((__m256i*)&out[i], _mm256_permutevar8x32_epi32(winner, lane_order));
+    }
+    batch_sse2(&positions[i], count - i, &out[i]);
+}
+
+static bool cpu_has_avx2(void) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    const bool os_saves_ymm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+    if (!os_saves_ymm) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif
+
+void game_check_winner_batch(const Position* positions, size_t count, Player* out) {
+    if (!positions || !out || count == 0) return;
+
+#ifdef WINBATCH_X86
+    static int use_avx2 = -1;
+    if (use_avx2 < 0) {
+        use_avx2 = cpu_has_avx2() ? 1 : 0;
+    }
+    if (use_avx2) {
+        batch_avx2(positions, count, out);
+    } else {
+        batch_sse2(positions, count, out);
+    }
+#else
+    batch_scalar(positions, count, out);
+#endif
+}
@@ -0,0 +1,13 @@
+#ifndef WINBATCH_H
+#define WINBATCH_H
+
+#include "position.h"
+#include <stddef.h>
+
+/* Winner of each position (X checked first), PLAYER_NONE when neither side
+ * has a line. Uses AVX2 or SSE2 when the CPU has them, for as long as the
+ * positions share one board size and win length; a batch that mixes them
+ * is finished one position at a time. */
+void game_check_winner_batch(const Position* positions, size_t count, Player* out);
+
+#endif
@@ -0,0 +1,53 @@
+#include "zobrist.h"
+
+/* Keys come from a fixed seed so every peer derives the same hash for a position. */
+#define ZOBRIST_SEED 0x5443582D5A4F4252ULL
+
+static uint64_t g_cell_keys[2][MAX_MOVES];
+static uint64_t g_side_key;
+static uint64_t g_size_keys[MAX_BOARD_SIZE + 1];
+static uint64_t g_win_keys[MAX_BOARD_SIZE + 1];
+static bool g_keys_ready = false;
+
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void zobrist_init(void) {
+    if (g_keys_ready) return;
+
+    uint64_t state = ZOBRIST_SEED;
+    for (int p = 0; p < 2; p++) {
+        for (int cell = 0; cell < MAX_MOVES; cell++) {
+            g_cell_keys[p][cell] = splitmix64(&state);
+        }
+    }
+    g_side_key = splitmix64(&state);
+    for (int size = 0; size <= MAX_BOARD_SIZE; size++) {
+        g_size_keys[size] = splitmix64(&state);
+    }
+    for (int length = 0; length <= MAX_BOARD_SIZE; length++) {
+        g_win_keys[length] = splitmix64(&state);
+    }
+    g_keys_ready = true;
+}
+
+uint64_t zobrist_cell(Player player, int cell) {
+    if (player == PLAYER_NONE || cell < 0 || cell >= MAX_MOVES) return 0;
+    zobrist_init();
+    return g_cell_keys[player - 1][cell];
+}
+
+uint64_t zobrist_side(void) {
+    zobrist_init();
+    return g_side_key;
+}
+
+uint64_t zobrist_rules(uint8_t size, uint8_t win_length) {
+    if (size > MAX_BOARD_SIZE || win_length > MAX_BOARD_SIZE) return 0;
+    zobrist_init();
+    return g_size_keys[size] ^ g_win_keys[win_length];
+}
@@ -0,0 +1,12 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "game.h"
+#include <stdint.h>
+
+void zobrist_init(void);
+uint64_t zobrist_cell(Player player, int cell);
+uint64_t zobrist_side(void);
+uint64_t zobrist_rules(uint8_t size, uint8_t win_length);
+
+#endif
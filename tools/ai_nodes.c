@@ -0,0 +1,79 @@
+#include "ai.h"
+#include "game.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NODES_MAX_OPENING 12
+
+/* Fixed positions for comparing search changes: board size, win length
+ * and the cells played so far, X first. */
+typedef struct {
+    const char* name;
+    uint8_t size;
+    uint8_t win_length;
+    int opening[NODES_MAX_OPENING];
+} NodePosition;
+
+static const NodePosition g_positions[] = {
+    {"4x4 k3 empty",       4, 3, {-1}},
+    {"4x4 k3 corner",      4, 3, {0, 5, -1}},
+    {"4x4 k4 centre",      4, 4, {5, 10, 6, -1}},
+    {"4x4 k4 edges",       4, 4, {1, 4, 14, 11, -1}},
+    {"5x5 k3 centre",      5, 3, {12, -1}},
+    {"5x5 k4 empty",       5, 4, {-1}},
+    {"5x5 k4 centre",      5, 4, {12, 6, -1}},
+    {"5x5 k4 diagonal",    5, 4, {12, 18, 6, 0, -1}},
+    {"5x5 k4 crowded",     5, 4, {12, 7, 13, 11, 17, 8, -1}},
+    {"5x5 k5 empty",       5, 5, {-1}},
+    {"5x5 k5 centre",      5, 5, {12, 6, 7, -1}},
+    {"5x5 k5 late",        5, 5, {12, 6, 7, 17, 2, 22, 8, 16, -1}},
+};
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [-j threads] [-H hash_mb]\n", program);
+    printf("Runs the hard AI at its fixed depth on a set of positions and reports node counts.\n");
+}
+
+int main(int argc, char* argv[]) {
+    int threads = 1;
+    int hash_mb = AI_DEFAULT_HASH_MB;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-H") == 0 && i + 1 < argc) {
+            hash_mb = atoi(argv[++i]);
+        } else {
+            print_usage(argv[0]);
+            return (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) ? 0 : 1;
+        }
+    }
+
+    ai_set_threads(threads);
+    ai_set_hash_size(hash_mb > 0 ? (size_t)hash_mb : 0);
+
+    uint64_t total = 0;
+    const size_t count = sizeof(g_positions) / sizeof(g_positions[0]);
+    printf("%-18s %6s %12s\n", "position", "move", "nodes");
+
+    for (size_t i = 0; i < count; i++) {
+        const NodePosition* p = &g_positions[i];
+        Game game;
+        game_init(&game, p->size, MODE_AI_HARD);
+        game_set_win_length(&game, p->win_length);
+        for (int m = 0; m < NODES_MAX_OPENING && p->opening[m] >= 0; m++) {
+            game_make_move(&game, (uint8_t)(p->opening[m] / p->size), (uint8_t)(p->opening[m] % p->size));
+        }
+
+        ai_clear_hash();
+        Move move;
+        ai_get_move(&game, &move);
+        const uint64_t nodes = ai_last_node_count();
+        total += nodes;
+        printf("%-18s  %u,%u %12llu\n", p->name, move.row + 1, move.col + 1, (unsigned long long)nodes);
+    }
+
+    printf("%-18s %6s %12llu\n", "total", "", (unsigned long long)total);
+    return 0;
+}
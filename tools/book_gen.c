@@ -0,0 +1,142 @@
+#include "ai.h"
+#include "book.h"
+#include "game.h"
+#include "monotime.h"
+#include "symmetry.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GEN_DEFAULT_PLIES 2
+#define GEN_DEFAULT_TIME_MS 1000
+#define GEN_MAX_BOOK_MOVES 4
+
+typedef struct {
+    BookEntry* entries;
+    size_t count;
+    size_t capacity;
+    uint64_t* seen;
+    size_t seen_count;
+    size_t seen_capacity;
+    int plies;
+    int time_ms;
+} BookBuilder;
+
+static bool append_entry(BookBuilder* b, uint64_t key, uint16_t cell, uint16_t weight) {
+    if (b->count == b->capacity) {
+        const size_t capacity = b->capacity ? b->capacity * 2 : 1024;
+        BookEntry* grown = (BookEntry*)realloc(b->entries, capacity * sizeof(BookEntry));
+        if (!grown) return false;
+        b->entries = grown;
+        b->capacity = capacity;
+    }
+    BookEntry* entry = &b->entries[b->count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->key = key;
+    entry->cell = cell;
+    entry->weight = weight;
+    return true;
+}
+
+/* True the first time a canonical key is offered. */
+static bool mark_seen(BookBuilder* b, uint64_t key) {
+    for (size_t i = 0; i < b->seen_count; i++) {
+        if (b->seen[i] == key) return false;
+    }
+    if (b->seen_count == b->seen_capacity) {
+        const size_t capacity = b->seen_capacity ? b->seen_capacity * 2 : 1024;
+        uint64_t* grown = (uint64_t*)realloc(b->seen, capacity * sizeof(uint64_t));
+        if (!grown) return false;
+        b->seen = grown;
+        b->seen_capacity = capacity;
+    }
+    b->seen[b->seen_count++] = key;
+    return true;
+}
+
+static bool add_position(BookBuilder* b, Game* game) {
+    uint8_t transform = SYMMETRY_IDENTITY;
+    const uint64_t key = game_canonical_key(game, &transform);
+    if (!mark_seen(b, key)) return true;
+
+    AiMoveScore scores[MAX_MOVES];
+    const int count = ai_score_moves(game, monotime_ms() + (uint64_t)b->time_ms, scores, MAX_MOVES);
+
+    /* Every move tied with the best score, earlier (better ordered) ones weighted higher. */
+    for (int i = 0; i < count && i < GEN_MAX_BOOK_MOVES && scores[i].score == scores[0].score; i++) {
+        const uint16_t cell = (uint16_t)(scores[i].move.row * game->size + scores[i].move.col);
+        const uint16_t canonical = symmetry_apply(game->size, (Symmetry)transform, cell);
+        if (!append_entry(b, key, canonical, (uint16_t)(GEN_MAX_BOOK_MOVES - i))) return false;
+    }
+
+    if (game->move_count >= b->plies) return true;
+
+    const uint8_t n = game->size;
+    for (uint8_t r = 0; r < n; r++) {
+        for (uint8_t c = 0; c < n; c++) {
+            if (game->board[r][c] != PLAYER_NONE) continue;
+            Game child = *game;
+            if (!game_make_move(&child, r, c) || child.state != GAME_STATE_PLAYING) continue;
+            if (!add_position(b, &child)) return false;
+        }
+    }
+    return true;
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [-p plies] [-t ms] [output]\n", program);
+    printf("Searches every 4x4 and 5x5 opening up to `plies` stones (default %d) for `ms`\n", GEN_DEFAULT_PLIES);
+    printf("milliseconds each (default %d) and writes the opening book (default %s).\n",
+           GEN_DEFAULT_TIME_MS, BOOK_DEFAULT_FILE);
+}
+
+int main(int argc, char* argv[]) {
+    static const uint8_t sizes[] = {4, 5};
+    const char* output = BOOK_DEFAULT_FILE;
+    BookBuilder builder;
+
+    memset(&builder, 0, sizeof(builder));
+    builder.plies = GEN_DEFAULT_PLIES;
+    builder.time_ms = GEN_DEFAULT_TIME_MS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            builder.plies = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            builder.time_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            output = argv[i];
+        }
+    }
+    if (builder.plies < 0) builder.plies = 0;
+    if (builder.time_ms < 1) builder.time_ms = 1;
+
+    const uint64_t started = monotime_ms();
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        Game game;
+        game_init(&game, sizes[s], MODE_AI_HARD);
+        game_set_win_length(&game, 0);
+
+        const size_t before = builder.seen_count;
+        if (!add_position(&builder, &game)) {
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+        printf("%ux%u (%u in a row): %zu positions\n", sizes[s], sizes[s], game.win_length,
+               builder.seen_count - before);
+    }
+
+    if (!book_write(output, builder.entries, builder.count)) {
+        fprintf(stderr, "Failed to write %s\n", output);
+        return 1;
+    }
+
+    printf("Wrote %zu moves to %s in %.1fs\n", builder.count, output,
+           (double)(monotime_ms() - started) / 1000.0);
+    free(builder.entries);
+    free(builder.seen);
+    return 0;
+}
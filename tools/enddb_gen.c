@@ -0,0 +1,149 @@
+#include "bitboard.h"
+#include "enddb.h"
+#include "thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GEN_MAX_THREADS 64
+#define GEN_CHUNK 4096
+
+typedef struct {
+    uint8_t* values;
+    BitboardWinKernel has_win;
+    int stones;
+    int worker;
+    int workers;
+} LayerJob;
+
+static uint8_t child_value(const uint8_t* values, uint16_t x, uint16_t o) {
+    uint16_t cx, co;
+    enddb_canonical(x, o, &cx, &co);
+    return values[enddb_index(cx, co)];
+}
+
+static uint8_t solve_position(const LayerJob* job, uint16_t x, uint16_t o) {
+    const int side = (job->stones % 2 == 0) ? 0 : 1;
+    const uint16_t own = side ? o : x;
+    const uint16_t other = side ? x : o;
+
+    if (job->has_win(other)) return ENDDB_VALUE(ENDDB_LOSS, 0);
+    if (job->has_win(own) || job->stones == ENDDB_CELLS) return ENDDB_VALUE(ENDDB_DRAW, 0);
+
+    int best_win = -1;
+    int best_draw = -1;
+    int longest_loss = -1;
+    const uint16_t empty = (uint16_t)~(x | o);
+
+    for (int cell = 0; cell < ENDDB_CELLS; cell++) {
+        const uint16_t bit = (uint16_t)(1u << cell);
+        if (!(empty & bit)) continue;
+
+        const uint8_t value = side ? child_value(job->values, x, o | bit) : child_value(job->values, x | bit, o);
+        const int distance = ENDDB_VALUE_DISTANCE(value) + 1;
+
+        switch (ENDDB_VALUE_RESULT(value)) {
+            case ENDDB_LOSS:
+                if (best_win < 0 || distance < best_win) best_win = distance;
+                break;
+            case ENDDB_DRAW:
+                if (best_draw < 0 || distance < best_draw) best_draw = distance;
+                break;
+            default:
+                if (distance > longest_loss) longest_loss = distance;
+                break;
+        }
+    }
+
+    if (best_win >= 0) return ENDDB_VALUE(ENDDB_WIN, best_win);
+    if (best_draw >= 0) return ENDDB_VALUE(ENDDB_DRAW, best_draw);
+    return ENDDB_VALUE(ENDDB_LOSS, longest_loss);
+}
+
+static void solve_layer_part(void* arg) {
+    const LayerJob* job = (const LayerJob*)arg;
+    const uint32_t start = enddb_layer_start(job->stones);
+    const uint32_t end = enddb_layer_start(job->stones + 1);
+
+    for (uint32_t chunk = start + (uint32_t)job->worker * GEN_CHUNK; chunk < end;
+         chunk += (uint32_t)job->workers * GEN_CHUNK) {
+        const uint32_t stop = (chunk + GEN_CHUNK < end) ? chunk + GEN_CHUNK : end;
+        for (uint32_t index = chunk; index < stop; index++) {
+            uint16_t x, o, cx, co;
+            enddb_unrank(index, &x, &o);
+            enddb_canonical(x, o, &cx, &co);
+            if (cx != x || co != o) continue;
+            job->values[index] = solve_position(job, x, o);
+        }
+    }
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [-j threads] [output]\n", program);
+    printf("Solves 4x4 four-in-a-row and writes the endgame database (default %s).\n", ENDDB_DEFAULT_FILE);
+}
+
+int main(int argc, char* argv[]) {
+    const char* output = ENDDB_DEFAULT_FILE;
+    int workers = thread_cpu_count();
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            workers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            output = argv[i];
+        }
+    }
+    if (workers < 1) workers = 1;
+    if (workers > GEN_MAX_THREADS) workers = GEN_MAX_THREADS;
+
+    enddb_init();
+    const uint32_t count = enddb_position_count();
+    uint8_t* values = (uint8_t*)calloc(count, 1);
+    if (!values) {
+        fprintf(stderr, "Out of memory for %u positions\n", count);
+        return 1;
+    }
+
+    const clock_t started = clock();
+    printf("Solving %u positions with %d threads\n", count, workers);
+
+    /* Every move adds a stone, so each layer depends only on the next one. */
+    for (int stones = ENDDB_CELLS; stones >= 0; stones--) {
+        Thread threads[GEN_MAX_THREADS];
+        LayerJob jobs[GEN_MAX_THREADS];
+
+        for (int w = 0; w < workers; w++) {
+            jobs[w].values = values;
+            jobs[w].has_win = bitboard_win_kernel(ENDDB_SIZE, ENDDB_SIZE);
+            jobs[w].stones = stones;
+            jobs[w].worker = w;
+            jobs[w].workers = workers;
+            if (!thread_start(&threads[w], solve_layer_part, &jobs[w])) {
+                solve_layer_part(&jobs[w]);
+            }
+        }
+        for (int w = 0; w < workers; w++) {
+            thread_join(&threads[w]);
+        }
+        printf("  layer %2d done\n", stones);
+    }
+
+    const uint8_t root = values[enddb_index(0, 0)];
+    static const char* names[] = {"unknown", "win", "loss", "draw"};
+    printf("Empty board: %s for X in %d plies\n", names[ENDDB_VALUE_RESULT(root)], ENDDB_VALUE_DISTANCE(root));
+
+    if (!enddb_write(output, values)) {
+        fprintf(stderr, "Failed to write %s\n", output);
+        free(values);
+        return 1;
+    }
+
+    printf("Wrote %s in %.1fs CPU\n", output, (double)(clock() - started) / CLOCKS_PER_SEC);
+    free(values);
+    return 0;
+}
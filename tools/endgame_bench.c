@@ -0,0 +1,224 @@
+#include "ai.h"
+#include "game.h"
+#include "monotime.h"
+#include "replay.h"
+#include "rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_DEFAULT_POSITIONS 40
+#define BENCH_DEFAULT_TIME_MS 10000
+#define BENCH_MAX_POSITIONS 4096
+
+/* Boards the exact solver covers; 3x3 always comes from the perfect table. */
+static const uint8_t g_boards[][2] = {{4, 3}, {4, 4}, {5, 4}, {5, 5}};
+
+typedef struct {
+    Game games[BENCH_MAX_POSITIONS];
+    int count;
+} PositionSet;
+
+typedef struct {
+    int positions;
+    uint64_t nodes;
+    uint64_t total_ms;
+    uint64_t max_ms;
+    int worse;          /* moves that give away a win or a draw */
+} BenchTotals;
+
+typedef struct {
+    uint8_t size;
+    uint8_t win_length;
+    BenchTotals exact;
+    BenchTotals search;
+} BoardReport;
+
+static void add_position(PositionSet* set, const Game* game) {
+    if (set->count < BENCH_MAX_POSITIONS) set->games[set->count++] = *game;
+}
+
+static int late_empties(uint8_t size, int empties) {
+    return (empties == AI_EXACT_AUTO) ? ai_exact_endgame_empties(size) : empties;
+}
+
+/* Every position in a replay with `empties` or fewer cells left. */
+static void collect_replay(PositionSet* set, const Replay* replay, int empties) {
+    if (replay->size < 4 || replay->size > 5) return;
+
+    Game game;
+    game_init(&game, replay->size, MODE_AI_HARD);
+    game_set_win_length(&game, replay->win_length);
+    if (replay->seed != 0) game_set_seed(&game, replay->seed);
+
+    const int late = late_empties(replay->size, empties);
+    for (int i = 0; i < replay->move_count && game.state == GAME_STATE_PLAYING; i++) {
+        if (game.size * game.size - game.move_count <= late) add_position(set, &game);
+        if (!game_make_move(&game, replay->moves[i].row, replay->moves[i].col)) return;
+    }
+}
+
+/* Random games stopped `empties` cells from the end, skipping any that
+ * are already over. */
+static void collect_random(PositionSet* set, int per_board, int empties, uint64_t seed) {
+    Rng rng;
+    rng_seed(&rng, seed);
+
+    for (size_t b = 0; b < sizeof(g_boards) / sizeof(g_boards[0]); b++) {
+        const uint8_t n = g_boards[b][0];
+        const int left = late_empties(n, empties);
+        for (int found = 0, tries = 0; found < per_board && tries < per_board * 100; tries++) {
+            Game game;
+            game_init(&game, n, MODE_AI_HARD);
+            game_set_win_length(&game, g_boards[b][1]);
+            while (game.state == GAME_STATE_PLAYING && n * n - game.move_count > left) {
+                const int cell = (int)rng_below(&rng, (uint32_t)(n * n));
+                if (game.board[cell / n][cell % n] == PLAYER_NONE) {
+                    game_make_move(&game, (uint8_t)(cell / n), (uint8_t)(cell % n));
+                }
+            }
+            if (game.state != GAME_STATE_PLAYING) continue;
+            add_position(set, &game);
+            found++;
+        }
+    }
+}
+
+static int outcome(int score) {
+    if (score >= AI_SCORE_DECIDED) return 1;
+    if (score <= -AI_SCORE_DECIDED) return -1;
+    return 0;
+}
+
+/* Win (1), draw (0) or loss (-1) for the side to move, by the exact solver. */
+static int solve_value(const Game* game, uint64_t deadline_ms) {
+    Game copy = *game;
+    Move move;
+    AiStats stats;
+    ai_set_exact_endgame(MAX_MOVES);
+    ai_get_move_timed(&copy, &move, deadline_ms);
+    ai_last_stats(&stats);
+    return outcome(stats.score);
+}
+
+static int move_value(const Game* game, const Move* move, uint64_t deadline_ms) {
+    Game child = *game;
+    if (!game_make_move(&child, move->row, move->col)) return -1;
+    if (child.state == GAME_STATE_WIN) return 1;
+    if (child.state == GAME_STATE_DRAW) return 0;
+    return -solve_value(&child, deadline_ms);
+}
+
+static void run_one(const Game* game, int empties, int time_ms, int best, BenchTotals* totals) {
+    Game copy = *game;
+    Move move;
+    AiStats stats;
+
+    ai_set_exact_endgame(empties);
+    ai_clear_hash();
+    const uint64_t deadline = time_ms > 0 ? monotime_ms() + (uint64_t)time_ms : 0;
+    ai_get_move_timed(&copy, &move, deadline);
+    ai_last_stats(&stats);
+
+    totals->positions++;
+    totals->nodes += stats.nodes;
+    totals->total_ms += stats.elapsed_ms;
+    if (stats.elapsed_ms > totals->max_ms) totals->max_ms = stats.elapsed_ms;
+
+    ai_clear_hash();
+    if (move_value(game, &move, 0) < best) totals->worse++;
+}
+
+static BoardReport* find_report(BoardReport* reports, int* count, const Game* game) {
+    for (int i = 0; i < *count; i++) {
+        if (reports[i].size == game->size && reports[i].win_length == game->win_length) return &reports[i];
+    }
+    BoardReport* report = &reports[(*count)++];
+    memset(report, 0, sizeof(*report));
+    report->size = game->size;
+    report->win_length = game->win_length;
+    return report;
+}
+
+static void print_totals(const char* name, const BenchTotals* t) {
+    if (t->positions == 0) return;
+    printf("  %-8s %10llu %9.1f %8llu %6d\n", name, (unsigned long long)t->nodes,
+           (double)t->total_ms / t->positions, (unsigned long long)t->max_ms, t->worse);
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [-e empties] [-n positions] [-t ms] [-s seed] [replay...]\n", program);
+    printf("Compares the hard AI's exact endgame solver with its heuristic search on late\n");
+    printf("positions: every position with `empties` or fewer free cells in the given replays,\n");
+    printf("or `positions` random ones per board (default %d) when none are given. Both get\n",
+           BENCH_DEFAULT_POSITIONS);
+    printf("`ms` per move (default %d, 0 runs the search at its fixed depth). Without -e the\n",
+           BENCH_DEFAULT_TIME_MS);
+    printf("tuned threshold for each board size is used.\n");
+}
+
+int main(int argc, char* argv[]) {
+    int empties = AI_EXACT_AUTO;
+    int per_board = BENCH_DEFAULT_POSITIONS;
+    int time_ms = BENCH_DEFAULT_TIME_MS;
+    uint64_t seed = 1;
+    int files = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            empties = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            per_board = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            time_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            argv[++files] = argv[i];
+        }
+    }
+
+    /* Too large for the stack. */
+    static PositionSet set;
+    static ReplayHistory history;
+    for (int f = 1; f <= files; f++) {
+        if (replay_history_load(&history, argv[f]) && history.count > 0) {
+            for (int i = 0; i < history.count; i++) {
+                collect_replay(&set, &history.replays[i], empties);
+            }
+        } else if (replay_load(&history.replays[0], argv[f])) {
+            collect_replay(&set, &history.replays[0], empties);
+        } else {
+            fprintf(stderr, "Failed to read %s\n", argv[f]);
+            return 1;
+        }
+    }
+    if (files == 0) collect_random(&set, per_board, empties, seed);
+
+    /* Keep the comparison to the two searches under test. */
+    ai_set_solver_size(0);
+
+    BoardReport reports[sizeof(g_boards) / sizeof(g_boards[0]) + 2];
+    int report_count = 0;
+    for (int i = 0; i < set.count; i++) {
+        const Game* game = &set.games[i];
+        BoardReport* report = find_report(reports, &report_count, game);
+
+        ai_clear_hash();
+        const int best = solve_value(game, 0);
+        run_one(game, empties, time_ms, best, &report->exact);
+        run_one(game, 0, time_ms, best, &report->search);
+    }
+
+    for (int i = 0; i < report_count; i++) {
+        const BoardReport* r = &reports[i];
+        printf("%ux%u, %u in a row: %d positions\n", r->size, r->size, r->win_length, r->exact.positions);
+        printf("  %-8s %10s %9s %8s %6s\n", "", "nodes", "avg ms", "max ms", "worse");
+        print_totals("exact", &r->exact);
+        print_totals("search", &r->search);
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "ai.h"
+#include "dfpn.h"
+#include "game.h"
+#include "monotime.h"
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SOLVE_DEFAULT_TIME_MS 5000
+
+typedef struct {
+    int time_ms;
+    uint64_t node_limit;
+    bool rank_moves;
+} SolveOptions;
+
+/* Grades a move by the value the mover had before it and the value the
+ * opponent has after it. */
+static const char* judge_move(DfpnResult before, DfpnResult after) {
+    if (before == DFPN_UNKNOWN || after == DFPN_UNKNOWN) return "";
+    if (before == DFPN_WIN && after != DFPN_LOSS) return "  missed win";
+    if (before == DFPN_DRAW && after == DFPN_WIN) return "  blunder (loses)";
+    return "";
+}
+
+static DfpnResult solve_position(const Game* game, const SolveOptions* options, uint64_t* nodes) {
+    if (game->state != GAME_STATE_PLAYING) return DFPN_UNKNOWN;
+
+    DfpnBudget budget;
+    budget.deadline_ms = options->time_ms > 0 ? monotime_ms() + (uint64_t)options->time_ms : 0;
+    budget.node_limit = options->node_limit;
+    budget.cancel = NULL;
+
+    Move move;
+    return dfpn_solve(game, &budget, &move, nodes);
+}
+
+/* Where the played move ranks among all moves by the hard AI's analysis,
+ * with the move it rates best. */
+static void print_rank(const Game* game, const Move* played, const SolveOptions* options) {
+    AiMoveAnalysis moves[MAX_MOVES];
+    const uint64_t deadline = options->time_ms > 0 ? monotime_ms() + (uint64_t)options->time_ms : 0;
+    const int count = ai_analyze_timed(game, deadline, moves, MAX_MOVES);
+
+    int rank = 0;
+    for (int i = 0; i < count; i++) {
+        if (moves[i].move.row == played->row && moves[i].move.col == played->col) {
+            /* Moves that tie the played one share its rank. */
+            rank = 1;
+            while (rank <= i && moves[rank - 1].score > moves[i].score) rank++;
+            break;
+        }
+    }
+    if (count == 0 || rank == 0) return;
+    printf("  rank %d/%d", rank, count);
+    if (rank > 1) printf(", best %u,%u", moves[0].move.row + 1, moves[0].move.col + 1);
+}
+
+static void solve_replay(const Replay* replay, const char* name, int index, const SolveOptions* options) {
+    printf("%s #%d: %ux%u, %u in a row, %d moves\n", name, index + 1,
+           replay->size, replay->size, replay->win_length, replay->move_count);
+
+    Game game;
+    game_init(&game, replay->size, MODE_LOCAL_2P);
+    game_set_win_length(&game, replay->win_length);
+    if (replay->seed != 0) game_set_seed(&game, replay->seed);
+    if (!dfpn_supports(&game)) {
+        printf("  skipped: the solver handles boards up to 5x5\n");
+        return;
+    }
+
+    printf("  %4s %6s %4s %8s %12s\n", "ply", "move", "side", "value", "nodes");
+    uint64_t nodes = 0;
+    DfpnResult before = solve_position(&game, options, &nodes);
+
+    for (int i = 0; i < replay->move_count && game.state == GAME_STATE_PLAYING; i++) {
+        const Move* m = &replay->moves[i];
+        const Player mover = game.current_player;
+        const uint64_t spent = nodes;
+        const Game before_move = game;
+        if (!game_make_move(&game, m->row, m->col)) {
+            printf("  %4d %3u,%-2u illegal move, stopping\n", i + 1, m->row + 1, m->col + 1);
+            return;
+        }
+
+        DfpnResult after = DFPN_UNKNOWN;
+        if (game.state == GAME_STATE_PLAYING) {
+            after = solve_position(&game, options, &nodes);
+        } else if (game.state == GAME_STATE_WIN) {
+            after = DFPN_LOSS;
+        } else {
+            after = DFPN_DRAW;
+        }
+
+        printf("  %4d %3u,%-2u %4c %8s %12llu%s", i + 1, m->row + 1, m->col + 1,
+               mover == PLAYER_X ? 'X' : 'O', dfpn_result_name(before),
+               (unsigned long long)spent, judge_move(before, after));
+        if (options->rank_moves) print_rank(&before_move, m, options);
+        printf("\n");
+        before = after;
+    }
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [-t ms] [-n nodes] [-m table_mb] [-a] replay...\n", program);
+    printf("Solves every position of each saved replay (or replay history) on boards up\n");
+    printf("to 5x5 and marks missed wins and losing moves. Each position gets `ms`\n");
+    printf("milliseconds (default %d, 0 for no limit) and at most `nodes` nodes.\n", SOLVE_DEFAULT_TIME_MS);
+    printf("With -a the hard AI also rates every move of each position in the same time\n");
+    printf("and the played move's rank is shown next to the best one.\n");
+}
+
+int main(int argc, char* argv[]) {
+    SolveOptions options;
+    options.time_ms = SOLVE_DEFAULT_TIME_MS;
+    options.node_limit = 0;
+    options.rank_moves = false;
+    int files = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            options.time_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            options.node_limit = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            const int mb = atoi(argv[++i]);
+            dfpn_set_table_size(mb > 0 ? (size_t)mb : DFPN_DEFAULT_TABLE_MB);
+        } else if (strcmp(argv[i], "-a") == 0) {
+            options.rank_moves = true;
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            argv[++files] = argv[i];
+        }
+    }
+    if (files == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    /* Too large for the stack. */
+    static ReplayHistory history;
+    int failed = 0;
+
+    for (int f = 1; f <= files; f++) {
+        const char* path = argv[f];
+        if (replay_history_load(&history, path) && history.count > 0) {
+            for (int i = 0; i < history.count; i++) {
+                solve_replay(&history.replays[i], path, i, &options);
+            }
+        } else if (replay_load(&history.replays[0], path)) {
+            solve_replay(&history.replays[0], path, 0, &options);
+        } else {
+            fprintf(stderr, "Failed to read %s\n", path);
+            failed++;
+        }
+    }
+    return failed ? 1 : 0;
+}
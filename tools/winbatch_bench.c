@@ -0,0 +1,138 @@
+#include "game.h"
+#include "monotime.h"
+#include "position.h"
+#include "rng.h"
+#include "winbatch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_DEFAULT_POSITIONS 1000000
+#define BENCH_DEFAULT_ROUNDS 20
+
+/* Board size and win length of each homogeneous set; the mixed set
+ * interleaves all of them. */
+static const uint8_t g_boards[][2] = {{3, 3}, {4, 4}, {5, 4}, {5, 5}};
+#define BENCH_BOARD_COUNT (sizeof(g_boards) / sizeof(g_boards[0]))
+
+/* A random game cut off at a random length, finished games included so
+ * that every outcome shows up. */
+static void random_position(Position* pos, uint8_t size, uint8_t win_length, Rng* rng) {
+    Game game;
+    game_init(&game, size, MODE_LOCAL_2P);
+    game_set_win_length(&game, win_length);
+
+    const int cells = size * size;
+    const int stop = (int)rng_below(rng, (uint32_t)cells + 1);
+    while (game.state == GAME_STATE_PLAYING && game.move_count < stop) {
+        const int cell = (int)rng_below(rng, (uint32_t)cells);
+        if (game.board[cell / size][cell % size] == PLAYER_NONE) {
+            game_make_move(&game, (uint8_t)(cell / size), (uint8_t)(cell % size));
+        }
+    }
+    (void)position_from_game(pos, &game);
+}
+
+/* The per-position loop the batch replaces: one kernel lookup and call per board. */
+static void winners_scalar(const Position* positions, size_t count, Player* out) {
+    for (size_t i = 0; i < count; i++) {
+        const Position* pos = &positions[i];
+        const BitboardWinKernel has_win = bitboard_win_kernel(position_size(pos), position_win_length(pos));
+        if (!has_win) out[i] = PLAYER_NONE;
+        else if (has_win(position_stones(pos, PLAYER_X))) out[i] = PLAYER_X;
+        else if (has_win(position_stones(pos, PLAYER_O))) out[i] = PLAYER_O;
+        else out[i] = PLAYER_NONE;
+    }
+}
+
+/* Best of `rounds` runs, in nanoseconds per position. */
+static double time_runs(void (*check)(const Position*, size_t, Player*), const Position* positions,
+                        size_t count, Player* out, int rounds) {
+    uint64_t best = 0;
+    for (int r = 0; r < rounds; r++) {
+        const uint64_t started = monotime_ns();
+        check(positions, count, out);
+        const uint64_t spent = monotime_ns() - started;
+        if (r == 0 || spent < best) best = spent;
+    }
+    return (double)best / (double)count;
+}
+
+static bool run_set(const char* name, const Position* positions, size_t count, int rounds,
+                    Player* expected, Player* actual) {
+    const double scalar = time_runs(winners_scalar, positions, count, expected, rounds);
+    const double batch = time_runs(game_check_winner_batch, positions, count, actual, rounds);
+
+    size_t wins = 0;
+    size_t mismatches = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (expected[i] != PLAYER_NONE) wins++;
+        if (expected[i] != actual[i]) mismatches++;
+    }
+    printf("  %-8s %8.2f %8.2f %7.2fx %8.1f%% %10zu\n", name, scalar, batch, scalar / batch,
+           100.0 * (double)wins / (double)count, mismatches);
+    return mismatches == 0;
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [-n positions] [-r rounds] [-s seed]\n", program);
+    printf("Times game_check_winner_batch() against a per-position loop on `positions`\n");
+    printf("random boards per set (default %d), best of `rounds` runs (default %d), and\n",
+           BENCH_DEFAULT_POSITIONS, BENCH_DEFAULT_ROUNDS);
+    printf("checks that both report the same winners. Exits non-zero on any mismatch.\n");
+}
+
+int main(int argc, char* argv[]) {
+    int count = BENCH_DEFAULT_POSITIONS;
+    int rounds = BENCH_DEFAULT_ROUNDS;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            rounds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else {
+            print_usage(argv[0]);
+            return (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) ? 0 : 1;
+        }
+    }
+    if (count < 1) count = 1;
+    if (rounds < 1) rounds = 1;
+
+    Position* positions = (Position*)malloc((size_t)count * sizeof(Position));
+    Player* expected = (Player*)malloc((size_t)count * sizeof(Player));
+    Player* actual = (Player*)malloc((size_t)count * sizeof(Player));
+    if (!positions || !expected || !actual) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    Rng rng;
+    rng_seed(&rng, seed);
+    bool ok = true;
+    char name[16];
+
+    printf("%d positions per set, best of %d runs (ns per position)\n", count, rounds);
+    printf("  %-8s %8s %8s %8s %9s %10s\n", "set", "scalar", "batch", "speedup", "won", "mismatches");
+    for (size_t b = 0; b < BENCH_BOARD_COUNT; b++) {
+        for (int i = 0; i < count; i++) {
+            random_position(&positions[i], g_boards[b][0], g_boards[b][1], &rng);
+        }
+        (void)snprintf(name, sizeof(name), "%ux%u k%u", g_boards[b][0], g_boards[b][0], g_boards[b][1]);
+        ok = run_set(name, positions, (size_t)count, rounds, expected, actual) && ok;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const uint8_t* board = g_boards[(size_t)i % BENCH_BOARD_COUNT];
+        random_position(&positions[i], board[0], board[1], &rng);
+    }
+    ok = run_set("mixed", positions, (size_t)count, rounds, expected, actual) && ok;
+
+    free(positions);
+    free(expected);
+    free(actual);
+    return ok ? 0 : 1;
+}